@@ -0,0 +1,270 @@
+//
+// Creation Date: Sun Oct 18 13:35:52 PDT 2026
+// Last Modified: Sun Oct 18 13:35:52 PDT 2026
+// Filename:      AllocTracker.cpp
+// Syntax:        C++11
+//
+// Description:   Heap allocation counting for the allocation-tracking
+//                build.  The replacement allocators forward to the glibc
+//                __libc_* functions, so this build is Linux/glibc only.
+//
+
+#include "AllocTracker.h"
+#include <sys/resource.h>
+
+#ifdef HCAL_ALLOC_TRACKING
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <malloc.h>
+#include <new>
+
+using namespace std;
+
+extern "C" {
+   void* __libc_malloc  (size_t size);
+   void* __libc_calloc  (size_t count, size_t size);
+   void* __libc_realloc (void* pointer, size_t size);
+   void  __libc_free    (void* pointer);
+   void* __libc_memalign(size_t alignment, size_t size);
+}
+
+static atomic<unsigned long long> allocations(0);
+static atomic<unsigned long long> allocatedBytes(0);
+static atomic<long long>          liveBytes(0);
+static atomic<long long>          peakBytes(0);
+
+static void addLive      (long long bytes);
+
+
+//////////////////////////////
+//
+// malloc, calloc, realloc, memalign, free -- counting replacements.
+//
+
+extern "C" void* malloc(size_t size) {
+   void* pointer = __libc_malloc(size);
+   if (pointer != NULL) {
+      allocations.fetch_add(1, memory_order_relaxed);
+      allocatedBytes.fetch_add(size, memory_order_relaxed);
+      addLive(malloc_usable_size(pointer));
+   }
+   return pointer;
+}
+
+
+extern "C" void* calloc(size_t count, size_t size) {
+   void* pointer = __libc_calloc(count, size);
+   if (pointer != NULL) {
+      allocations.fetch_add(1, memory_order_relaxed);
+      allocatedBytes.fetch_add(count * size, memory_order_relaxed);
+      addLive(malloc_usable_size(pointer));
+   }
+   return pointer;
+}
+
+
+extern "C" void* realloc(void* pointer, size_t size) {
+   long long oldSize = pointer ? malloc_usable_size(pointer) : 0;
+   void* newPointer = __libc_realloc(pointer, size);
+   if (newPointer != NULL) {
+      allocations.fetch_add(1, memory_order_relaxed);
+      allocatedBytes.fetch_add(size, memory_order_relaxed);
+      addLive((long long)malloc_usable_size(newPointer) - oldSize);
+   }
+   return newPointer;
+}
+
+
+extern "C" void* memalign(size_t alignment, size_t size) {
+   void* pointer = __libc_memalign(alignment, size);
+   if (pointer != NULL) {
+      allocations.fetch_add(1, memory_order_relaxed);
+      allocatedBytes.fetch_add(size, memory_order_relaxed);
+      addLive(malloc_usable_size(pointer));
+   }
+   return pointer;
+}
+
+
+extern "C" void* aligned_alloc(size_t alignment, size_t size) {
+   return memalign(alignment, size);
+}
+
+
+extern "C" int posix_memalign(void** pointer, size_t alignment,
+      size_t size) {
+   *pointer = memalign(alignment, size);
+   return *pointer == NULL ? ENOMEM : 0;
+}
+
+
+extern "C" void free(void* pointer) {
+   if (pointer != NULL) {
+      addLive(-(long long)malloc_usable_size(pointer));
+   }
+   __libc_free(pointer);
+}
+
+
+
+//////////////////////////////
+//
+// operator new/delete -- forward to the counting malloc and free.
+//
+
+void* operator new(size_t size) {
+   void* pointer = malloc(size ? size : 1);
+   if (pointer == NULL) {
+      throw bad_alloc();
+   }
+   return pointer;
+}
+
+
+void* operator new[](size_t size) {
+   return operator new(size);
+}
+
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+   return malloc(size ? size : 1);
+}
+
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+   return malloc(size ? size : 1);
+}
+
+
+void operator delete(void* pointer) noexcept {
+   free(pointer);
+}
+
+
+void operator delete[](void* pointer) noexcept {
+   free(pointer);
+}
+
+
+void operator delete(void* pointer, const nothrow_t&) noexcept {
+   free(pointer);
+}
+
+
+void operator delete[](void* pointer, const nothrow_t&) noexcept {
+   free(pointer);
+}
+
+
+
+//////////////////////////////
+//
+// addLive -- adjust the number of live heap bytes and the peak.
+//
+
+static void addLive(long long bytes) {
+   long long live = liveBytes.fetch_add(bytes, memory_order_relaxed) + bytes;
+   long long peak = peakBytes.load(memory_order_relaxed);
+   while (live > peak && !peakBytes.compare_exchange_weak(peak, live,
+         memory_order_relaxed)) {
+      // retry with updated peak
+   }
+}
+
+#endif  // HCAL_ALLOC_TRACKING
+
+
+//////////////////////////////
+//
+// AllocTracker::isEnabled -- returns true in the allocation-tracking build.
+//
+
+int AllocTracker::isEnabled(void) {
+#ifdef HCAL_ALLOC_TRACKING
+   return 1;
+#else
+   return 0;
+#endif
+}
+
+
+
+//////////////////////////////
+//
+// AllocTracker::reset -- clear the allocation counts.  The peak is reset
+//     to the currently live heap size.
+//
+
+void AllocTracker::reset(void) {
+#ifdef HCAL_ALLOC_TRACKING
+   allocations.store(0);
+   allocatedBytes.store(0);
+   peakBytes.store(liveBytes.load());
+#endif
+}
+
+
+
+//////////////////////////////
+//
+// AllocTracker::getAllocations -- number of allocations since reset().
+//
+
+unsigned long long AllocTracker::getAllocations(void) {
+#ifdef HCAL_ALLOC_TRACKING
+   return allocations.load();
+#else
+   return 0;
+#endif
+}
+
+
+
+//////////////////////////////
+//
+// AllocTracker::getBytes -- number of bytes requested since reset().
+//
+
+unsigned long long AllocTracker::getBytes(void) {
+#ifdef HCAL_ALLOC_TRACKING
+   return allocatedBytes.load();
+#else
+   return 0;
+#endif
+}
+
+
+
+//////////////////////////////
+//
+// AllocTracker::getPeakBytes -- largest live heap size since reset().
+//
+
+long long AllocTracker::getPeakBytes(void) {
+#ifdef HCAL_ALLOC_TRACKING
+   return peakBytes.load();
+#else
+   return 0;
+#endif
+}
+
+
+
+//////////////////////////////
+//
+// AllocTracker::getPeakRss -- peak resident set size of the process in
+//     kilobytes.
+//
+
+long AllocTracker::getPeakRss(void) {
+   struct rusage usage;
+   if (getrusage(RUSAGE_SELF, &usage) != 0) {
+      return 0;
+   }
+   return usage.ru_maxrss;
+}
+
+
+
@@ -0,0 +1,32 @@
+//
+// Creation Date: Sun Oct 18 13:35:52 PDT 2026
+// Last Modified: Sun Oct 18 13:35:52 PDT 2026
+// Filename:      AllocTracker.h
+// Syntax:        C++11
+//
+// Description:   Heap allocation counting for the allocation-tracking
+//                build (make alloccheck, which defines HCAL_ALLOC_TRACKING).
+//                In that build malloc, calloc, realloc, free and the
+//                global operator new/delete are replaced by counting
+//                versions.  In normal builds all counts are zero.
+//
+
+#ifndef _ALLOCTRACKER_H_INCLUDED
+#define _ALLOCTRACKER_H_INCLUDED
+
+
+class AllocTracker {
+   public:
+      static int                isEnabled       (void);
+      static void               reset           (void);
+      static unsigned long long getAllocations  (void);
+      static unsigned long long getBytes        (void);
+      static long long          getPeakBytes    (void);
+      static long               getPeakRss      (void);
+};
+
+
+#endif  // _ALLOCTRACKER_H_INCLUDED
+
+
+
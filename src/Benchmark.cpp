@@ -0,0 +1,353 @@
+//
+// Creation Date: Sun Oct 18 12:41:07 PDT 2026
+// Last Modified: Sun Oct 18 22:20:38 PDT 2026
+// Filename:      Benchmark.cpp
+// Syntax:        C++11
+//
+// Description:   Micro-benchmarks of the Calendar conversion and rendering
+//                functions (--benchmark).
+//
+
+#include "AllocTracker.h"
+#include "Benchmark.h"
+#include "Calendar.h"
+#include "DateParser.h"
+#include "HistoricDate.h"
+#include "PerfCounters.h"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+// Number of dates per batch call in benchSortedDates():
+#define BENCHMARK_BLOCK    1024
+
+// Each benchmark function performs the given number of operations and
+// returns a checksum so that the work cannot be optimized away.
+typedef long long (*BenchmarkFunction)(long long count);
+
+class BenchmarkEntry {
+   public:
+      const char*        name;
+      BenchmarkFunction  function;
+      long long          count;          // default number of operations
+      int                zeroAlloc;      // must not allocate memory
+};
+
+static long long benchNiceneDay      (long long count);
+static long long benchInverse        (long long count);
+static long long benchPackedDate     (long long count);
+static long long benchParseDate      (long long count);
+static long long benchSortedDates    (long long count);
+static long long benchRenderMonth    (long long count);
+static long long benchPrintMonth     (long long count);
+static long long benchPrintYear      (long long count);
+
+static const BenchmarkEntry benchmarks[] = {
+   { "niceneDay",   benchNiceneDay,   10000000, 1 },
+   { "inverse",     benchInverse,      2000000, 1 },
+   { "packedDate",  benchPackedDate,   2000000, 1 },
+   { "sortedDates", benchSortedDates, 10000000, 1 },
+   { "parseDate",   benchParseDate,    2000000, 1 },
+   { "renderMonth", benchRenderMonth,    50000, 1 },
+   { "printMonth",  benchPrintMonth,     50000, 0 },
+   { "printYear",   benchPrintYear,       5000, 0 }
+};
+
+static volatile long long checksum = 0;
+
+
+//////////////////////////////
+//
+// Benchmark::Benchmark --
+//
+
+Benchmark::Benchmark(void) {
+   countersQ = 0;
+   scale     = 1.0;
+}
+
+
+
+//////////////////////////////
+//
+// Benchmark::~Benchmark --
+//
+
+Benchmark::~Benchmark() { }
+
+
+
+//////////////////////////////
+//
+// Benchmark::run -- run all benchmarks and print a table of the results.
+//     Returns the exit status for the program.  In the allocation-tracking
+//     build, allocations and peak heap/RSS are also reported, and the
+//     status is 1 if a benchmark marked as zero-allocation allocated any
+//     memory.  default value: out = cout
+//
+
+int Benchmark::run(ostream& out) {
+   PerfCounters counters;
+   if (countersQ) {
+      counters.open();
+      if (!counters.anyAvailable()) {
+         out << "Hardware counters unavailable: " << counters.getError()
+             << endl;
+      }
+   }
+
+   int i;
+   int status = 0;
+   out << left << setw(12) << "benchmark" << right << setw(10) << "ops"
+       << setw(10) << "ns/op";
+   if (counters.anyAvailable()) {
+      for (i=0; i<PERF_COUNTER_COUNT; i++) {
+         out << setw(18) << PerfCounters::getName(i);
+      }
+   }
+   if (AllocTracker::isEnabled()) {
+      out << setw(12) << "allocs" << setw(14) << "peak-heap" 
+          << setw(12) << "peak-rss-kB";
+   }
+   out << '\n';
+
+   int count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+   for (int b=0; b<count; b++) {
+      long long ops = (long long)(benchmarks[b].count * scale);
+      if (ops < 1) {
+         ops = 1;
+      }
+
+      AllocTracker::reset();
+      auto start = chrono::steady_clock::now();
+      counters.start();
+      checksum += benchmarks[b].function(ops);
+      counters.stop();
+      auto stop = chrono::steady_clock::now();
+
+      double ns = chrono::duration<double, nano>(stop - start).count();
+      out << left << setw(12) << benchmarks[b].name << right << setw(10)
+          << ops << setw(10) << fixed << setprecision(1) << ns / ops;
+      if (counters.anyAvailable()) {
+         for (i=0; i<PERF_COUNTER_COUNT; i++) {
+            if (counters.isAvailable(i)) {
+               out << setw(18) << setprecision(2)
+                   << (double)counters.getValue(i) / ops;
+            } else {
+               out << setw(18) << "n/a";
+            }
+         }
+      }
+      if (AllocTracker::isEnabled()) {
+         unsigned long long allocs = AllocTracker::getAllocations();
+         out << setw(12) << allocs << setw(14) << AllocTracker::getPeakBytes()
+             << setw(12) << AllocTracker::getPeakRss();
+         if (benchmarks[b].zeroAlloc && allocs > 0) {
+            out << "  FAIL: allocates";
+            status = 1;
+         }
+      }
+      out << endl;
+   }
+
+   return status;
+}
+
+
+
+//////////////////////////////
+//
+// Benchmark::setCounters -- read hardware counters for each benchmark.
+//
+
+void Benchmark::setCounters(int state) {
+   countersQ = state ? 1 : 0;
+}
+
+
+
+//////////////////////////////
+//
+// Benchmark::setScale -- multiply the number of operations of each
+//     benchmark.
+//
+
+void Benchmark::setScale(double aScale) {
+   scale = aScale;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// benchmark functions
+//
+
+//////////////////////////////
+//
+// benchNiceneDay -- date to Nicene day conversion, alternating calendars.
+//
+
+static long long benchNiceneDay(long long count) {
+   long long sum = 0;
+   for (long long i=0; i<count; i++) {
+      int calendar = (i & 1) ? CALENDAR_GREGORIAN : CALENDAR_JULIAN;
+      sum += Calendar::niceneDay(calendar, 1500 + (int)(i % 500),
+            1 + (int)(i % 12), 1 + (int)(i % 28));
+   }
+   return sum;
+}
+
+
+
+//////////////////////////////
+//
+// benchInverse -- Nicene day to year, month and day in the England locale.
+//
+
+static long long benchInverse(long long count) {
+   long long sum = 0;
+   int start = Calendar::niceneDay(CALENDAR_JULIAN, 1500, 1, 1);
+   for (long long i=0; i<count; i++) {
+      int nday = start + (int)(i % 182500);
+      sum += Calendar::getYear(LOCALE_ENGLAND, nday);
+      sum += Calendar::getMonth(LOCALE_ENGLAND, nday);
+      sum += Calendar::getDay(LOCALE_ENGLAND, nday);
+   }
+   return sum;
+}
+
+
+
+//////////////////////////////
+//
+// benchPackedDate -- Nicene day to HistoricDate and back in the England
+//     locale.
+//
+
+static long long benchPackedDate(long long count) {
+   long long sum = 0;
+   int start = Calendar::niceneDay(CALENDAR_JULIAN, 1500, 1, 1);
+   for (long long i=0; i<count; i++) {
+      int nday = start + (int)(i % 182500);
+      HistoricDate date = HistoricDate::fromNiceneDay(LOCALE_ENGLAND, nday);
+      sum += date.getNiceneDay() + date.getDay();
+   }
+   return sum;
+}
+
+
+
+//////////////////////////////
+//
+// benchSortedDates -- batch conversion of consecutive Nicene days in the
+//     England locale, which uses the stepping path of getDates().
+//
+
+static long long benchSortedDates(long long count) {
+   int ndays[BENCHMARK_BLOCK];
+   int years[BENCHMARK_BLOCK];
+   int months[BENCHMARK_BLOCK];
+   int days[BENCHMARK_BLOCK];
+   int start = Calendar::niceneDay(CALENDAR_JULIAN, 1700, 1, 1);
+   long long sum = 0;
+   for (long long i=0; i<count; i+=BENCHMARK_BLOCK) {
+      int size = BENCHMARK_BLOCK;
+      if (count - i < size) {
+         size = (int)(count - i);
+      }
+      for (int k=0; k<size; k++) {
+         ndays[k] = start + (int)((i + k) % 182500);
+      }
+      Calendar::getDates(LOCALE_ENGLAND, ndays, years, months, days, size);
+      sum += years[size-1] + months[size-1] + days[size-1];
+   }
+   return sum;
+}
+
+
+
+//////////////////////////////
+//
+// benchParseDate -- parse date strings in several forms.
+//
+
+static long long benchParseDate(long long count) {
+   static const char* dates[] = {
+      "14 9 1752", "1752-09-14", "14 Sep 1752", "September 14, 1752",
+      "1 février 1750/51", "1 января 1918", "22 ottobre 1587", "3rd Mar 1701"
+   };
+   long long sum = 0;
+   int year, month, day;
+   for (long long i=0; i<count; i++) {
+      if (DateParser::parse(dates[i & 7], year, month, day)) {
+         sum += year + month + day;
+      }
+   }
+   return sum;
+}
+
+
+
+//////////////////////////////
+//
+// benchRenderMonth -- render single months in the England locale
+//     into a caller buffer.
+//
+
+static long long benchRenderMonth(long long count) {
+   long long sum = 0;
+   Calendar cal;
+   char buffer[CALENDAR_MONTH_SIZE];
+   for (long long i=0; i<count; i++) {
+      cal.setDate(1700 + (int)(i / 12 % 100), 1 + (int)(i % 12), 1,
+            LOCALE_ENGLAND);
+      sum += cal.renderMonth(buffer, CALENDAR_MONTH_SIZE);
+   }
+   return sum;
+}
+
+
+
+//////////////////////////////
+//
+// benchPrintMonth -- render single months in the England locale.
+//
+
+static long long benchPrintMonth(long long count) {
+   long long sum = 0;
+   Calendar cal;
+   stringstream out;
+   for (long long i=0; i<count; i++) {
+      cal.setDate(1700 + (int)(i / 12 % 100), 1 + (int)(i % 12), 1,
+            LOCALE_ENGLAND);
+      out.str("");
+      cal.printMonth(out);
+      sum += out.tellp();
+   }
+   return sum;
+}
+
+
+
+//////////////////////////////
+//
+// benchPrintYear -- render whole years in the England locale.
+//
+
+static long long benchPrintYear(long long count) {
+   long long sum = 0;
+   Calendar cal;
+   stringstream out;
+   for (long long i=0; i<count; i++) {
+      cal.setDate(1700 + (int)(i % 100), 1, 1, LOCALE_ENGLAND);
+      out.str("");
+      cal.printYear(out, (int)(i & 1));
+      sum += out.tellp();
+   }
+   return sum;
+}
+
+
+
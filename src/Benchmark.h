@@ -0,0 +1,38 @@
+//
+// Creation Date: Sun Oct 18 12:41:07 PDT 2026
+// Last Modified: Sun Oct 18 12:41:07 PDT 2026
+// Filename:      Benchmark.h
+// Syntax:        C++11
+//
+// Description:   Micro-benchmarks of the Calendar conversion and rendering
+//                functions (--benchmark).  Reports wall time per operation
+//                and optionally hardware counters per operation (--perf).
+//
+
+#ifndef _BENCHMARK_H_INCLUDED
+#define _BENCHMARK_H_INCLUDED
+
+#include <iostream>
+
+using namespace std;
+
+
+class Benchmark {
+   public:
+                         Benchmark       (void);
+                        ~Benchmark       ();
+
+      int                run             (ostream& out = cout);
+      void               setCounters     (int state);
+      void               setScale        (double aScale);
+
+   private:
+      int                countersQ;      // read hardware counters
+      double             scale;          // multiplier for operation counts
+};
+
+
+#endif  // _BENCHMARK_H_INCLUDED
+
+
+
@@ -0,0 +1,666 @@
+//
+// Creation Date: Sun Oct 18 15:04:26 PDT 2026
+// Last Modified: Sun Oct 18 20:14:51 PDT 2026
+// Filename:      BulkConverter.cpp
+// Syntax:        C++11
+//
+// Description:   Parallel conversion of a text file of dates from one
+//                locale to another (--convert-file).
+//
+
+#include "BulkConverter.h"
+#include "Calendar.h"
+#include "ColumnarFormat.h"
+#include "DateCache.h"
+#include "DateParser.h"
+#include "DeltaStream.h"
+#include "NumberFormat.h"
+#include "Probes.h"
+#include "Stats.h"
+#include "Trace.h"
+#include "Workers.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+// Largest output record: "-99999999 12 31\n" is well under this.
+#define BULK_RECORD_SIZE   32
+
+// Chunks smaller than this are not split further between threads:
+#define BULK_MIN_CHUNK     (1 << 20)
+
+// Record status values:
+#define RECORD_BLANK       0
+#define RECORD_DATE        1
+#define RECORD_INVALID     2
+#define RECORD_IMPOSSIBLE  3    /* a date which did not exist */
+
+
+//////////////////////////////
+//
+// BulkConverter::BulkConverter --
+//
+
+BulkConverter::BulkConverter(void) {
+   fromLocale  = LOCALE_ENGLAND;
+   toLocale    = LOCALE_GREGORIAN;
+   format      = BULK_FORMAT_TEXT;
+   threadCount = Workers::getDefaultThreadCount();
+   checkDates  = 0;
+   skippedCount = 0;
+   impossibleCount = 0;
+}
+
+
+
+//////////////////////////////
+//
+// BulkConverter::~BulkConverter --
+//
+
+BulkConverter::~BulkConverter() { }
+
+
+
+//////////////////////////////
+//
+// BulkConverter::convertDays -- convert count Nicene days, replacing the
+//     contents of output with them in the output format.
+//
+
+void BulkConverter::convertDays(const int* ndays, int count, string& output) {
+   int    years[BULK_BLOCK_SIZE];
+   int    months[BULK_BLOCK_SIZE];
+   int    days[BULK_BLOCK_SIZE];
+
+   output.clear();
+   if (format == BULK_FORMAT_DELTA) {
+      DeltaWriter::encode(ndays, count, output);
+      return;
+   }
+
+   if (format == BULK_FORMAT_COLUMNAR) {
+      output.resize(ColumnarBlock::getTotalSize(count));
+      char* blockStart = &output[0];
+      for (int row=0; row<count; row+=COLUMNAR_BLOCK_ROWS) {
+         int rows = count - row;
+         if (rows > COLUMNAR_BLOCK_ROWS) {
+            rows = COLUMNAR_BLOCK_ROWS;
+         }
+         ColumnarBlock block;
+         block.create(blockStart, rows);
+         memcpy(block.nicene, ndays + row, (size_t)rows * sizeof(int));
+         Calendar::getDates(toLocale, block.nicene, block.year, block.month,
+               block.day, rows);
+         for (int i=0; i<rows; i++) {
+            block.calendar[i] = (block.nicene[i] >= toLocale &&
+                  toLocale != LOCALE_JULIAN) ? COLUMNAR_GREGORIAN :
+                  COLUMNAR_JULIAN;
+            block.weekday[i] = (unsigned char)((block.nicene[i] % 7 + 13) % 7);
+         }
+         block.finish();
+         blockStart += ColumnarBlock::getSize(rows);
+      }
+      return;
+   }
+
+   size_t length = 0;
+   for (int start=0; start<count; start+=BULK_BLOCK_SIZE) {
+      int n = count - start;
+      if (n > BULK_BLOCK_SIZE) {
+         n = BULK_BLOCK_SIZE;
+      }
+      Calendar::getDates(toLocale, ndays + start, years, months, days, n);
+      output.resize(length + (size_t)n * BULK_RECORD_SIZE);
+      char* out = &output[length];
+      for (int i=0; i<n; i++) {
+         out = writeInt(out, days[i]);
+         *out++ = ' ';
+         out = writeInt(out, months[i]);
+         *out++ = ' ';
+         out = writeInt(out, years[i]);
+         *out++ = '\n';
+      }
+      length = out - &output[0];
+   }
+   output.resize(length);
+}
+
+
+
+//////////////////////////////
+//
+// BulkConverter::convertFile -- convert the dates in the given file and
+//     write them to output.  Returns the exit status for the program,
+//     which is 1 if corrupt blocks of a delta stream were left out.
+//     default value: output = stdout
+//
+
+int BulkConverter::convertFile(const string& filename, FILE* output) {
+   int fd = open(filename.c_str(), O_RDONLY);
+   if (fd < 0) {
+      cerr << "Error: cannot open " << filename << ": " << strerror(errno)
+           << endl;
+      return 1;
+   }
+   struct stat info;
+   if (fstat(fd, &info) != 0) {
+      cerr << "Error: cannot read " << filename << endl;
+      close(fd);
+      return 1;
+   }
+   size_t size = info.st_size;
+   const char* data = "";
+   void* mapping = MAP_FAILED;
+   if (size > 0) {
+      mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED) {
+         cerr << "Error: cannot map " << filename << ": " << strerror(errno)
+              << endl;
+         close(fd);
+         return 1;
+      }
+      madvise(mapping, size, MADV_SEQUENTIAL);
+      data = (const char*)mapping;
+   }
+
+   // a delta stream of Nicene days is split at block boundaries, and
+   // text is split into newline-aligned chunks:
+   DeltaReader reader;
+   int deltaInput = DeltaReader::isDeltaStream(data, size);
+   if (deltaInput && !reader.open(data, size)) {
+      cerr << "Error: " << filename << " is not a valid delta stream" << endl;
+      munmap(mapping, size);
+      close(fd);
+      return 1;
+   }
+   size_t chunkCount = (size_t)threadCount * 4;
+   vector<const char*> bounds;
+   vector<int> blockBounds;
+   if (deltaInput) {
+      if (chunkCount > (size_t)reader.getBlockCount()) {
+         chunkCount = reader.getBlockCount();
+      }
+      blockBounds.resize(chunkCount + 1);
+      for (size_t k=0; k<=chunkCount; k++) {
+         blockBounds[k] = (int)((long long)reader.getBlockCount() * k /
+               chunkCount);
+      }
+   } else {
+      if (chunkCount > size / BULK_MIN_CHUNK + 1) {
+         chunkCount = size / BULK_MIN_CHUNK + 1;
+      }
+      if (size == 0) {
+         chunkCount = 0;
+      }
+      bounds.resize(chunkCount + 1);
+      bounds[0] = data;
+      for (size_t k=1; k<chunkCount; k++) {
+         const char* p = data + size / chunkCount * k;
+         if (p < bounds[k-1]) {
+            p = bounds[k-1];
+         }
+         const char* newline = (const char*)memchr(p, '\n', data + size - p);
+         bounds[k] = newline ? newline + 1 : data + size;
+      }
+      bounds[chunkCount] = data + size;
+   }
+
+   DeltaWriter deltaWriter;
+   if (format == BULK_FORMAT_COLUMNAR) {
+      char header[COLUMNAR_ALIGNMENT];
+      ColumnarBlock::fileHeader(header, toLocale);
+      fwrite(header, 1, COLUMNAR_ALIGNMENT, output);
+      Stats::recordWrite(COLUMNAR_ALIGNMENT);
+   } else if (format == BULK_FORMAT_DELTA) {
+      deltaWriter.open(output);
+   }
+
+   vector<string> outputs(chunkCount);
+   atomic<long long> lostCount(0);
+   skippedCount = 0;
+   impossibleCount = 0;
+
+   Workers::runOrdered(threadCount, chunkCount, chunkCount, "convert",
+         [&](size_t k) {
+      TraceSpan span("convertChunk", "chunk", (int)k);
+      if (deltaInput) {
+         int first = blockBounds[k];
+         int last = blockBounds[k+1];
+         vector<int> ndays((size_t)(reader.getBlockStart(last) -
+               reader.getBlockStart(first)));
+         if (!ndays.empty()) {
+            int n = reader.decodeBlocks(first, last - 1, &ndays[0],
+                  (int)ndays.size());
+            lostCount += (long long)ndays.size() - n;
+            convertDays(&ndays[0], n, outputs[k]);
+         }
+      } else {
+         convertText(bounds[k], bounds[k+1], outputs[k]);
+      }
+   }, [&](size_t k) {
+      // write the chunks in input order as they are finished:
+      TraceSpan span("output", "chunk", (int)k);
+      Stats::startPhase(STATS_PHASE_OUTPUT);
+      if (format == BULK_FORMAT_DELTA) {
+         deltaWriter.write(outputs[k]);
+      } else {
+         fwrite(outputs[k].data(), 1, outputs[k].size(), output);
+      }
+      Stats::recordWrite(outputs[k].size());
+      Stats::stopPhase(STATS_PHASE_OUTPUT);
+      string().swap(outputs[k]);
+   });
+
+   if (mapping != MAP_FAILED) {
+      munmap(mapping, size);
+   }
+   close(fd);
+   if (format == BULK_FORMAT_DELTA) {
+      deltaWriter.close();
+      if (skippedCount > 0) {
+         cerr << "Warning: " << skippedCount << " lines without a date "
+              << "were left out of the delta stream" << endl;
+      }
+   }
+   if (lostCount > 0) {
+      cerr << "Error: " << lostCount << " values of corrupt delta stream "
+           << "blocks could not be decoded" << endl;
+   }
+   if (impossibleCount > 0) {
+      cerr << "Warning: " << impossibleCount << " dates which did not exist "
+           << "in the input locale were "
+           << (format == BULK_FORMAT_TEXT ? "written as \"!\"" :
+               format == BULK_FORMAT_COLUMNAR ? "written without a date" :
+               "left out") << endl;
+   }
+   fflush(output);
+   return ferror(output) || lostCount > 0 ? 1 : 0;
+}
+
+
+
+//////////////////////////////
+//
+// BulkConverter::convertText -- convert the lines between start and end,
+//     replacing the contents of output.  Each line holds a date in one of
+//     the DateParser forms.  In the text format blank lines are copied
+//     and unparsable lines are written as "?".  In the columnar format
+//     each line is a row, and rows without a date have the calendar
+//     COLUMNAR_NO_DATE.  In the delta format the Nicene days of the
+//     dates are written and lines without a date are left out.
+//
+
+void BulkConverter::convertText(const char* start, const char* end,
+      string& output) {
+   if (format == BULK_FORMAT_COLUMNAR) {
+      convertColumnar(start, end, output);
+      return;
+   } else if (format == BULK_FORMAT_DELTA) {
+      convertToDelta(start, end, output);
+      return;
+   }
+
+   int    years[BULK_BLOCK_SIZE];
+   int    months[BULK_BLOCK_SIZE];
+   int    days[BULK_BLOCK_SIZE];
+   int    ndays[BULK_BLOCK_SIZE];
+   char   status[BULK_BLOCK_SIZE];
+
+   output.clear();
+   size_t length = 0;
+   const char* p = start;
+   while (p < end) {
+      // parse and convert a block of records:
+      int count = parseBlock(p, end, BULK_BLOCK_SIZE, years, months, days,
+            status);
+      convertRecords(years, months, days, status, ndays, years, months, days,
+            count);
+
+      // format the block:
+      output.resize(length + (size_t)count * BULK_RECORD_SIZE);
+      char* out = &output[length];
+      for (int i=0; i<count; i++) {
+         switch (status[i]) {
+            case RECORD_DATE:
+               out = writeInt(out, days[i]);
+               *out++ = ' ';
+               out = writeInt(out, months[i]);
+               *out++ = ' ';
+               out = writeInt(out, years[i]);
+               break;
+            case RECORD_INVALID:
+               *out++ = '?';
+               break;
+            case RECORD_IMPOSSIBLE:
+               *out++ = '!';
+               break;
+         }
+         *out++ = '\n';
+         HCAL_PROBE1(batch__record__end, i);
+      }
+      length = out - &output[0];
+   }
+   output.resize(length);
+}
+
+
+
+//////////////////////////////
+//
+// BulkConverter::setCheckDates -- flag the dates which did not exist in
+//     the input locale if value is true.
+//
+
+void BulkConverter::setCheckDates(int value) {
+   checkDates = value;
+}
+
+
+
+//////////////////////////////
+//
+// BulkConverter::setFormat -- BULK_FORMAT_TEXT or BULK_FORMAT_COLUMNAR.
+//
+
+void BulkConverter::setFormat(int aFormat) {
+   format = aFormat;
+}
+
+
+
+//////////////////////////////
+//
+// BulkConverter::setFromLocale -- set the locale of the input dates.
+//
+
+void BulkConverter::setFromLocale(int aLocale) {
+   fromLocale = aLocale;
+}
+
+
+
+//////////////////////////////
+//
+// BulkConverter::setThreadCount -- set the number of worker threads,
+//     or the number of hardware threads if count is less than 1.
+//
+
+void BulkConverter::setThreadCount(int count) {
+   if (count < 1) {
+      threadCount = Workers::getDefaultThreadCount();
+   } else {
+      threadCount = count;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// BulkConverter::setToLocale -- set the locale of the output dates.
+//
+
+void BulkConverter::setToLocale(int aLocale) {
+   toLocale = aLocale;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// BulkConverter::convertColumnar -- convert the lines between start and
+//     end into columnar blocks.  The batch conversions write straight
+//     into the block columns.
+//
+
+void BulkConverter::convertColumnar(const char* start, const char* end,
+      string& output) {
+   int    years[BULK_BLOCK_SIZE];
+   int    months[BULK_BLOCK_SIZE];
+   int    days[BULK_BLOCK_SIZE];
+   char   status[BULK_BLOCK_SIZE];
+
+   // every line, including a last line without a newline, is a row:
+   long long rows = 0;
+   const char* p = start;
+   while (p < end && (p = (const char*)memchr(p, '\n', end - p)) != NULL) {
+      rows++;
+      p++;
+   }
+   if (end > start && end[-1] != '\n') {
+      rows++;
+   }
+
+   output.resize(ColumnarBlock::getTotalSize(rows));
+   char* blockStart = &output[0];
+   p = start;
+   while (rows > 0) {
+      int blockRows = rows < COLUMNAR_BLOCK_ROWS ? (int)rows :
+            COLUMNAR_BLOCK_ROWS;
+      ColumnarBlock block;
+      block.create(blockStart, blockRows);
+      int row = 0;
+      while (row < blockRows) {
+         int size = blockRows - row;
+         if (size > BULK_BLOCK_SIZE) {
+            size = BULK_BLOCK_SIZE;
+         }
+         int count = parseBlock(p, end, size, years, months, days, status);
+         int* ndays = block.nicene + row;
+         convertRecords(years, months, days, status, ndays, block.year + row,
+               block.month + row, block.day + row, count);
+         for (int i=0; i<count; i++) {
+            int r = row + i;
+            if (status[i] != RECORD_DATE) {
+               block.nicene[r]   = 0;
+               block.year[r]     = 0;
+               block.month[r]    = 0;
+               block.day[r]      = 0;
+               block.calendar[r] = COLUMNAR_NO_DATE;
+               block.weekday[r]  = 0;
+            } else {
+               block.calendar[r] = (ndays[i] >= toLocale &&
+                     toLocale != LOCALE_JULIAN) ? COLUMNAR_GREGORIAN :
+                     COLUMNAR_JULIAN;
+               block.weekday[r] = (unsigned char)((ndays[i] % 7 + 13) % 7);
+            }
+            HCAL_PROBE1(batch__record__end, r);
+         }
+         row += count;
+      }
+      block.finish();
+      blockStart += ColumnarBlock::getSize(blockRows);
+      rows -= blockRows;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// BulkConverter::convertRecords -- convert count parsed records to Nicene
+//     days and dates in the output locale.  The output arrays may be the
+//     same as the input arrays.  With --cache, dates are looked up in the
+//     cache first and the rest are converted together and added to it.
+//
+
+void BulkConverter::convertRecords(const int* years, const int* months,
+      const int* days, const char* status, int* ndays, int* outYears,
+      int* outMonths, int* outDays, int count) {
+   if (!DateCache::isEnabled()) {
+      Calendar::niceneDays(fromLocale, years, months, days, ndays, count);
+      Calendar::getDates(toLocale, ndays, outYears, outMonths, outDays,
+            count);
+      return;
+   }
+
+   int    index[BULK_BLOCK_SIZE];
+   int    missYears[BULK_BLOCK_SIZE];
+   int    missMonths[BULK_BLOCK_SIZE];
+   int    missDays[BULK_BLOCK_SIZE];
+   int    missNdays[BULK_BLOCK_SIZE];
+   int    missCount = 0;
+   int    hits = 0;
+
+   for (int i=0; i<count; i++) {
+      if (status[i] != RECORD_DATE) {
+         continue;
+      }
+      int year = years[i];
+      int month = months[i];
+      int day = days[i];
+      if (DateCache::findConversion(fromLocale, toLocale, year, month, day,
+            ndays[i], outYears[i], outMonths[i], outDays[i])) {
+         hits++;
+         continue;
+      }
+      index[missCount]      = i;
+      missYears[missCount]  = year;
+      missMonths[missCount] = month;
+      missDays[missCount]   = day;
+      missCount++;
+   }
+   Stats::count(STATS_COUNT_CONVERTHIT, hits);
+   Stats::count(STATS_COUNT_CONVERTMISS, missCount);
+   if (missCount == 0) {
+      return;
+   }
+
+   Calendar::niceneDays(fromLocale, missYears, missMonths, missDays,
+         missNdays, missCount);
+   for (int k=0; k<missCount; k++) {
+      ndays[index[k]] = missNdays[k];
+   }
+   // the input dates are still needed for the cache keys:
+   int    dates[3][BULK_BLOCK_SIZE];
+   Calendar::getDates(toLocale, missNdays, dates[0], dates[1], dates[2],
+         missCount);
+   for (int k=0; k<missCount; k++) {
+      int i = index[k];
+      outYears[i]  = dates[0][k];
+      outMonths[i] = dates[1][k];
+      outDays[i]   = dates[2][k];
+      DateCache::storeConversion(fromLocale, toLocale, missYears[k],
+            missMonths[k], missDays[k], missNdays[k], dates[0][k],
+            dates[1][k], dates[2][k]);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// BulkConverter::convertToDelta -- encode the Nicene days of the dates
+//     in the lines between start and end as delta stream blocks.
+//
+
+void BulkConverter::convertToDelta(const char* start, const char* end,
+      string& output) {
+   int    years[BULK_BLOCK_SIZE];
+   int    months[BULK_BLOCK_SIZE];
+   int    days[BULK_BLOCK_SIZE];
+   int    ndays[BULK_BLOCK_SIZE];
+   char   status[BULK_BLOCK_SIZE];
+
+   vector<int> values;
+   long long skipped = 0;
+   const char* p = start;
+   while (p < end) {
+      int count = parseBlock(p, end, BULK_BLOCK_SIZE, years, months, days,
+            status);
+      Calendar::niceneDays(fromLocale, years, months, days, ndays, count);
+      for (int i=0; i<count; i++) {
+         if (status[i] == RECORD_DATE) {
+            values.push_back(ndays[i]);
+         } else if (status[i] == RECORD_INVALID) {
+            skipped++;
+         }
+      }
+   }
+   skippedCount += skipped;
+   output.clear();
+   if (!values.empty()) {
+      DeltaWriter::encode(&values[0], (int)values.size(), output);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// BulkConverter::parseBlock -- parse up to maxCount lines starting at p,
+//     moving p past them.  Lines without a date are given the date
+//     1 Jan 2000 so that they can be converted with the rest of the
+//     block, as are dates which did not exist in the input locale when
+//     they are checked.  Returns the number of lines read.
+//
+
+int BulkConverter::parseBlock(const char*& p, const char* end, int maxCount,
+      int* years, int* months, int* days, char* status) {
+   int count = 0;
+   while (count < maxCount && p < end) {
+      HCAL_PROBE1(batch__record__start, p);
+      const char* eol = (const char*)memchr(p, '\n', end - p);
+      if (eol == NULL) {
+         eol = end;
+      }
+      while (p < eol && (*p == ' ' || *p == '\t' || *p == '\r')) {
+         p++;
+      }
+      int day, month, year;
+      if (p == eol) {
+         status[count] = RECORD_BLANK;
+      } else if (!DateParser::parse(p, eol, year, month, day) ||
+            year > CALENDAR_MAX_YEAR) {
+         status[count] = RECORD_INVALID;
+      } else {
+         status[count] = RECORD_DATE;
+      }
+      if (status[count] == RECORD_DATE) {
+         years[count]  = year;
+         months[count] = month;
+         days[count]   = day;
+      } else {
+         years[count]  = 2000;
+         months[count] = 1;
+         days[count]   = 1;
+      }
+      count++;
+      p = eol + 1;
+   }
+
+   if (checkDates) {
+      char valid[BULK_BLOCK_SIZE];
+      Calendar::validDates(fromLocale, years, months, days, valid, count);
+      int impossible = 0;
+      for (int i=0; i<count; i++) {
+         if (!valid[i] && status[i] == RECORD_DATE) {
+            status[i] = RECORD_IMPOSSIBLE;
+            years[i]  = 2000;
+            months[i] = 1;
+            days[i]   = 1;
+            impossible++;
+         }
+      }
+      if (impossible > 0) {
+         impossibleCount += impossible;
+      }
+   }
+   return count;
+}
+
+
+
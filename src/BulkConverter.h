@@ -0,0 +1,89 @@
+//
+// Creation Date: Sun Oct 18 15:04:26 PDT 2026
+// Last Modified: Mon Oct 19 01:05:12 PDT 2026
+// Filename:      BulkConverter.h
+// Syntax:        C++11
+//
+// Description:   Parallel conversion of a text file of dates, one date
+//                per line in any DateParser form, from one locale to
+//                another (--convert-file).  The input is memory mapped
+//                and split into newline-aligned chunks which are
+//                converted by worker threads with the Calendar batch
+//                functions.  The output of each chunk is written in
+//                input order.  The input may instead be a delta stream of
+//                Nicene days (see DeltaStream.h), which is split into
+//                chunks at block boundaries.
+//
+// With setCheckDates(), dates which did not exist in the input locale (a
+// day beyond the end of its month, or a day dropped by the reform of the
+// locale, see Calendar::isValidDate()) are flagged while the block is
+// converted: they are written as "!" lines in the text format, as rows
+// without a date in the columnar format, and left out of a delta stream.
+//
+
+#ifndef _BULKCONVERTER_H_INCLUDED
+#define _BULKCONVERTER_H_INCLUDED
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+using namespace std;
+
+// Number of records converted per call to the Calendar batch functions:
+#define BULK_BLOCK_SIZE    1024
+
+// Output formats:
+#define BULK_FORMAT_UNKNOWN  -1
+#define BULK_FORMAT_TEXT      0    /* "day month year" lines */
+#define BULK_FORMAT_COLUMNAR  1    /* see ColumnarFormat.h   */
+#define BULK_FORMAT_DELTA     2    /* see DeltaStream.h      */
+
+
+class BulkConverter {
+   public:
+                         BulkConverter   (void);
+                        ~BulkConverter   ();
+
+      void               convertDays     (const int* ndays, int count,
+                                            string& output);
+      int                convertFile     (const string& filename,
+                                            FILE* output = stdout);
+      void               convertText     (const char* start, const char* end,
+                                            string& output);
+      void               setCheckDates   (int value);
+      void               setFormat       (int aFormat);
+      void               setFromLocale   (int aLocale);
+      void               setThreadCount  (int count);
+      void               setToLocale     (int aLocale);
+
+
+   private:
+      int                fromLocale;     // locale of the input dates
+      int                toLocale;       // locale of the output dates
+      int                threadCount;    // number of worker threads
+      int                format;         // BULK_FORMAT_TEXT, _COLUMNAR, etc.
+      int                checkDates;     // flag dates which did not exist
+      atomic<long long>  skippedCount;   // lines left out of delta output
+      atomic<long long>  impossibleCount;  // flagged dates
+
+      void               convertColumnar (const char* start, const char* end,
+                                            string& output);
+      void               convertRecords  (const int* years, const int* months,
+                                            const int* days,
+                                            const char* status, int* ndays,
+                                            int* outYears, int* outMonths,
+                                            int* outDays, int count);
+      void               convertToDelta  (const char* start, const char* end,
+                                            string& output);
+      int                parseBlock      (const char*& p, const char* end,
+                                            int maxCount, int* years,
+                                            int* months, int* days,
+                                            char* status);
+};
+
+
+#endif  // _BULKCONVERTER_H_INCLUDED
+
+
+
@@ -0,0 +1,85 @@
+//
+// Creation Date: Mon Oct 19 03:48:09 PDT 2026
+// Last Modified: Mon Oct 19 03:48:09 PDT 2026
+// Filename:      ByteOrder.h
+// Syntax:        C++11
+//
+// Description:   Little-endian integer fields of the binary file formats
+//                (ColumnarFormat.h, DayTable.h, DeltaStream.h and
+//                PageStore.h), shared so that the formats are read and
+//                written the same way on any host.
+//
+
+#ifndef _BYTEORDER_H_INCLUDED
+#define _BYTEORDER_H_INCLUDED
+
+#include <cstring>
+
+
+//////////////////////////////
+//
+// bigEndianHost -- returns true if ints are stored most significant
+//     byte first.
+//
+
+inline int bigEndianHost(void) {
+   unsigned int one = 1;
+   unsigned char first;
+   memcpy(&first, &one, 1);
+   return first == 0;
+}
+
+
+
+//////////////////////////////
+//
+// readUint32 -- read a little-endian 32-bit integer.
+//
+
+inline unsigned int readUint32(const char* p) {
+   const unsigned char* u = (const unsigned char*)p;
+   return u[0] | (u[1] << 8) | (u[2] << 16) | ((unsigned int)u[3] << 24);
+}
+
+
+
+//////////////////////////////
+//
+// readUint64 -- read a little-endian 64-bit integer.
+//
+
+inline unsigned long long readUint64(const char* p) {
+   return readUint32(p) | ((unsigned long long)readUint32(p + 4) << 32);
+}
+
+
+
+//////////////////////////////
+//
+// writeUint32 -- write a little-endian 32-bit integer.
+//
+
+inline void writeUint32(char* p, unsigned int value) {
+   p[0] = (char)(value & 0xff);
+   p[1] = (char)((value >> 8) & 0xff);
+   p[2] = (char)((value >> 16) & 0xff);
+   p[3] = (char)((value >> 24) & 0xff);
+}
+
+
+
+//////////////////////////////
+//
+// writeUint64 -- write a little-endian 64-bit integer.
+//
+
+inline void writeUint64(char* p, unsigned long long value) {
+   writeUint32(p, (unsigned int)(value & 0xffffffff));
+   writeUint32(p + 4, (unsigned int)(value >> 32));
+}
+
+
+#endif  // _BYTEORDER_H_INCLUDED
+
+
+
@@ -27,20 +27,71 @@
 
 
 #include "Calendar.h"
+#include "DateCache.h"
+#include "DayCursor.h"
+#include "DayTable.h"
+#include "Probes.h"
+#include "Stats.h"
+#include "Trace.h"
 #include <cstring>
 #include <iomanip>
-#include <sstream>
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
 
 using namespace std;
 
+// Number of dates converted together by the batch date arithmetic:
+#define CALENDAR_BLOCK_SIZE  1024
+
 // declaration of static variables:
 const int Calendar::monthday[13] = {
       0, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
 const int Calendar::lmonthday[13] = {
       0, 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335};
 
+// locale codes and names, in order of adoption of the Gregorian calendar:
+const int Calendar::localeCode[LOCALE_COUNT] = {
+      LOCALE_GREGORIAN, LOCALE_ROME, LOCALE_FRANCE, LOCALE_BAVARIA,
+      LOCALE_AUSTRIA, LOCALE_LUCERNE, LOCALE_HUNGARY, LOCALE_NORWAY,
+      LOCALE_ZURICH, LOCALE_ENGLAND, LOCALE_RUSSIA, LOCALE_ROMANIA,
+      LOCALE_GREECE, LOCALE_TURKEY, LOCALE_JULIAN};
+const char* Calendar::localeName[LOCALE_COUNT] = {
+      "Gregorian", "Rome", "France", "Bavaria", "Austria", "Lucerne",
+      "Hungary", "Norway", "Zurich", "England", "Russia", "Romania",
+      "Greece", "Turkey", "Julian"};
+
+// table engine, set by setDayTable():
+const unsigned int* Calendar::dayTable      = NULL;
+int                 Calendar::dayTableFirst = 0;
+unsigned int        Calendar::dayTableCount = 0;
+
+// names accepted by getLocaleByName() (same as the command-line options):
+const LocaleAlias Calendar::localeAlias[] = {
+      {"gregorian", LOCALE_GREGORIAN}, {"g", LOCALE_GREGORIAN},
+      {"julian", LOCALE_JULIAN}, {"j", LOCALE_JULIAN},
+      {"rome", LOCALE_ROME}, {"italy", LOCALE_ROME}, {"i", LOCALE_ROME},
+      {"france", LOCALE_FRANCE}, {"f", LOCALE_FRANCE},
+      {"bavaria", LOCALE_BAVARIA}, {"b", LOCALE_BAVARIA},
+      {"austria", LOCALE_AUSTRIA}, {"bohemia", LOCALE_AUSTRIA},
+      {"slovakia", LOCALE_AUSTRIA}, {"a", LOCALE_AUSTRIA},
+      {"lucerne", LOCALE_LUCERNE}, {"catholic-switzerland", LOCALE_LUCERNE},
+      {"l", LOCALE_LUCERNE},
+      {"hungary", LOCALE_HUNGARY}, {"h", LOCALE_HUNGARY},
+      {"norway", LOCALE_NORWAY}, {"denmark", LOCALE_NORWAY},
+      {"danmark", LOCALE_NORWAY}, {"n", LOCALE_NORWAY},
+      {"zurich", LOCALE_ZURICH}, {"protestant-switzerland", LOCALE_ZURICH},
+      {"z", LOCALE_ZURICH},
+      {"england", LOCALE_ENGLAND}, {"uk", LOCALE_ENGLAND},
+      {"ireland", LOCALE_ENGLAND}, {"scotland", LOCALE_ENGLAND},
+      {"u", LOCALE_ENGLAND},
+      {"russia", LOCALE_RUSSIA}, {"r", LOCALE_RUSSIA},
+      {"romania", LOCALE_ROMANIA}, {"m", LOCALE_ROMANIA},
+      {"greece", LOCALE_GREECE}, {"hellas", LOCALE_GREECE},
+      {"e", LOCALE_GREECE},
+      {"turkey", LOCALE_TURKEY}, {"t", LOCALE_TURKEY},
+      {NULL, LOCALE_UNKNOWN}};
+
 
 //////////////////////////////
 //
@@ -63,6 +114,145 @@ Calendar::~Calendar() { }
 
 
 
+//////////////////////////////
+//
+// Calendar::addDays -- move a date of a locale by delta days (backwards
+//     if delta is negative).  The date is converted to its Nicene day as
+//     in setDate(), so the result is correct across a reform gap:
+//     2 September 1752 + 1 day is 14 September 1752 in England.  The
+//     batch form moves count dates in place by their own deltas; their
+//     months and days are not validated.
+//
+
+void Calendar::addDays(int aLocale, int delta, int& year, int& month,
+      int& day) {
+   int calendar = getCalendar(aLocale, year, month, day);
+   getDate(aLocale, niceneDay(calendar, year, month, day) + delta, year,
+         month, day);
+}
+
+
+void Calendar::addDays(int aLocale, const int* deltas, int* years,
+      int* months, int* days, int count) {
+   int ndays[CALENDAR_BLOCK_SIZE];
+   for (int start=0; start<count; start+=CALENDAR_BLOCK_SIZE) {
+      int n = count - start;
+      if (n > CALENDAR_BLOCK_SIZE) {
+         n = CALENDAR_BLOCK_SIZE;
+      }
+      niceneDays(aLocale, years + start, months + start, days + start,
+            ndays, n);
+      for (int i=0; i<n; i++) {
+         ndays[i] += deltas[start + i];
+      }
+      getDates(aLocale, ndays, years + start, months + start, days + start,
+            n);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// Calendar::countWeekdays -- the number of days from the first to the last
+//     day inclusive (Nicene days, or dates of a locale) whose weekday is in
+//     weekdayMask, such as WEEKDAY_MASK_SUNDAY or WEEKDAY_MASK_WORKDAYS.
+//     Days dropped by a reform have no Nicene day, so they are never
+//     counted, and the weekdays run on unbroken across the reform.  Each
+//     weekday w is on the Nicene days congruent to w+1 modulo 7, so it is
+//     counted with two divisions.  Returns 0 if the last day is before
+//     the first.  The batch form writes the count of each pair of dates
+//     to output; their months and days are not validated.
+//
+
+int Calendar::countWeekdays(int firstDay, int lastDay, int weekdayMask) {
+   if (lastDay < firstDay) {
+      return 0;
+   }
+   int count = 0;
+   for (int w=0; w<7; w++) {
+      if (weekdayMask & (1 << w)) {
+         count += floorDivide(lastDay - w - 1, 7) -
+               floorDivide(firstDay - w - 2, 7);
+      }
+   }
+   return count;
+}
+
+
+int Calendar::countWeekdays(int aLocale, int year1, int month1, int day1,
+      int year2, int month2, int day2, int weekdayMask) {
+   int calendar1 = getCalendar(aLocale, year1, month1, day1);
+   int calendar2 = getCalendar(aLocale, year2, month2, day2);
+   return countWeekdays(niceneDay(calendar1, year1, month1, day1),
+         niceneDay(calendar2, year2, month2, day2), weekdayMask);
+}
+
+
+void Calendar::countWeekdays(int aLocale, const int* years1,
+      const int* months1, const int* days1, const int* years2,
+      const int* months2, const int* days2, int weekdayMask, int* output,
+      int count) {
+   int firstDays[CALENDAR_BLOCK_SIZE];
+   int lastDays[CALENDAR_BLOCK_SIZE];
+   for (int start=0; start<count; start+=CALENDAR_BLOCK_SIZE) {
+      int n = count - start;
+      if (n > CALENDAR_BLOCK_SIZE) {
+         n = CALENDAR_BLOCK_SIZE;
+      }
+      niceneDays(aLocale, years1 + start, months1 + start, days1 + start,
+            firstDays, n);
+      niceneDays(aLocale, years2 + start, months2 + start, days2 + start,
+            lastDays, n);
+      for (int i=0; i<n; i++) {
+         output[start + i] = countWeekdays(firstDays[i], lastDays[i],
+               weekdayMask);
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// Calendar::daysBetween -- the number of days from the first date to the
+//     second date of a locale (negative if the second date is earlier),
+//     leaving out the days dropped by a reform between them.  The batch
+//     form writes the difference of each pair of dates to output, which
+//     must not overlap the input arrays; their months and days are not
+//     validated.
+//
+
+int Calendar::daysBetween(int aLocale, int year1, int month1, int day1,
+      int year2, int month2, int day2) {
+   int calendar1 = getCalendar(aLocale, year1, month1, day1);
+   int calendar2 = getCalendar(aLocale, year2, month2, day2);
+   return niceneDay(calendar2, year2, month2, day2) -
+         niceneDay(calendar1, year1, month1, day1);
+}
+
+
+void Calendar::daysBetween(int aLocale, const int* years1,
+      const int* months1, const int* days1, const int* years2,
+      const int* months2, const int* days2, int* output, int count) {
+   int ndays[CALENDAR_BLOCK_SIZE];
+   for (int start=0; start<count; start+=CALENDAR_BLOCK_SIZE) {
+      int n = count - start;
+      if (n > CALENDAR_BLOCK_SIZE) {
+         n = CALENDAR_BLOCK_SIZE;
+      }
+      niceneDays(aLocale, years1 + start, months1 + start, days1 + start,
+            ndays, n);
+      niceneDays(aLocale, years2 + start, months2 + start, days2 + start,
+            output + start, n);
+      for (int i=0; i<n; i++) {
+         output[start + i] -= ndays[i];
+      }
+   }
+}
+
+
+
 //////////////////////////////
 //
 // Calendar::daysInYear -- return the number of days in the year of 
@@ -110,6 +300,36 @@ int Calendar::dayOfYear(int calendar, int year, int month, int day) {
 
 
 
+//////////////////////////////
+//
+// Calendar::firstDayFrom -- the first Nicene day whose date in the
+//     locale is on or after the given date.  This is the day of the date,
+//     or the day after a reform gap which dropped the date.  The Julian
+//     and the Gregorian days of the date bound the answer, since the date
+//     of a Nicene day in a locale is its date in one of the two
+//     calendars, so it is found by a binary search between them.
+//
+
+int Calendar::firstDayFrom(int aLocale, int year, int month, int day) {
+   int julian = niceneDay(CALENDAR_JULIAN, year, month, day);
+   int gregorian = niceneDay(CALENDAR_GREGORIAN, year, month, day);
+   int low = julian < gregorian ? julian : gregorian;
+   int high = julian < gregorian ? gregorian : julian;
+   while (low < high) {
+      int middle = low + (high - low) / 2;
+      int y, m, d;
+      getDate(aLocale, middle, y, m, d);
+      if (y > year || (y == year && (m > month || (m == month && d >= day)))) {
+         high = middle;
+      } else {
+         low = middle + 1;
+      }
+   }
+   return low;
+}
+
+
+
 //////////////////////////////
 //
 // Calendar::getCalendar -- returns the calendar associated with a specific
@@ -128,11 +348,15 @@ int Calendar::getCalendar(int aLocale, int year, int month, int day) {
 
 
 int Calendar::getCalendar(int aLocale, int aNiceneDay) {
-   if (aNiceneDay >= aLocale) {
-      return CALENDAR_GREGORIAN;
+   Stats::count(STATS_COUNT_GETCALENDAR);
+   int calendar;
+   if (aNiceneDay >= aLocale && aLocale != LOCALE_JULIAN) {
+      calendar = CALENDAR_GREGORIAN;
    } else {
-      return CALENDAR_JULIAN;
+      calendar = CALENDAR_JULIAN;
    }
+   HCAL_PROBE3(calendar__resolve, aLocale, aNiceneDay, calendar);
+   return calendar;
 }
 
 
@@ -166,42 +390,67 @@ const char* Calendar::getCalendarName(int calendar) {
 
 //////////////////////////////
 //
-// Calendar::getDay -- return the day of the month.
+// Calendar::getDate -- convert a Nicene day into the year, month and
+//     day of the calendar in use by the locale on that day.
 //
 
-int Calendar::getDay(int aLocale, int aNiceneDay) {
+void Calendar::getDate(int aLocale, int aNiceneDay, int& year, int& month,
+      int& day) {
+   HCAL_PROBE2(inverse__entry, aLocale, aNiceneDay);
    int calendar = getCalendar(aLocale, aNiceneDay);
-   int year = getYear(aLocale, aNiceneDay);
-   
-   int yearNicene = niceneDay(calendar, year, 1, 1);
+   splitDay(calendar, aNiceneDay, year, month, day);
+   HCAL_PROBE1(inverse__return, year);
+}
 
-   int dayofyear = aNiceneDay - yearNicene;
 
-   
-   const int* montharray;
-   if (leapYear(calendar, year)) {
-      montharray = lmonthday;
-   } else {
-      montharray = monthday;
-   }
 
-   int month = 1;
-   while (month < 13 && montharray[month] <= dayofyear) {
-      month++;
-   }
-   month--;
-   if (month == 0) {
-      month = 1;
-   }
-   if (month >= 13) {
-      month = 12;
-   }
- 
-   if (month < 1 || month > 12) {
-      cout << "Error in getDay, month is: " << month << endl;
+//////////////////////////////
+//
+// Calendar::getDates -- batch version of getDate() for count Nicene days.
+//     When a day is within CALENDAR_STEP_LIMIT days of the previous one
+//     and in the same calendar, its date is found by stepping from the
+//     previous date, so sorted input costs little more than a copy.
+//     The output arrays must not overlap niceneDays.
+//
+
+void Calendar::getDates(int aLocale, const int* niceneDays, int* years,
+      int* months, int* days, int count) {
+   Stats::count(STATS_COUNT_GETCALENDAR, count);
+   int stepped = 0;
+   int lastCalendar = CALENDAR_UNKNOWN;
+   for (int i=0; i<count; i++) {
+      int calendar = CALENDAR_JULIAN;
+      if (niceneDays[i] >= aLocale && aLocale != LOCALE_JULIAN) {
+         calendar = CALENDAR_GREGORIAN;
+      }
+      int delta = i > 0 ? niceneDays[i] - niceneDays[i-1] : 0;
+      if (calendar == lastCalendar && delta >= -CALENDAR_STEP_LIMIT &&
+            delta <= CALENDAR_STEP_LIMIT) {
+         years[i]  = years[i-1];
+         months[i] = months[i-1];
+         days[i]   = days[i-1];
+         stepDate(calendar, delta, years[i], months[i], days[i]);
+         stepped++;
+      } else {
+         splitDay(calendar, niceneDays[i], years[i], months[i], days[i]);
+      }
+      lastCalendar = calendar;
    }
+   Stats::count(STATS_COUNT_STEPPED, stepped);
+}
+
 
-   return dayofyear - montharray[month] + 1;
+
+//////////////////////////////
+//
+// Calendar::getDay -- return the day of the month.
+//
+
+int Calendar::getDay(int aLocale, int aNiceneDay) {
+   Stats::count(STATS_COUNT_GETDAY);
+   int year, month, day;
+   getDate(aLocale, aNiceneDay, year, month, day);
+   return day;
 }
 
 
@@ -211,6 +460,40 @@ int Calendar::getDay(void) {
 
 
 
+//////////////////////////////
+//
+// Calendar::getDroppedDays -- returns the number of dates which the reform
+//     of a locale left out (such as 3-13 September 1752 in England), and
+//     stores the first size of them in the arrays in order.
+//     CALENDAR_DROPPED_SIZE is enough for every locale.  These
+//     are the Julian dates from the first Gregorian day of the locale up
+//     to its Gregorian date, so Norway drops 29 February 1700 as well.
+//     LOCALE_GREGORIAN and LOCALE_JULIAN drop no dates.
+//
+
+int Calendar::getDroppedDays(int aLocale, int* years, int* months, int* days,
+      int size) {
+   if (aLocale == LOCALE_UNKNOWN || aLocale == LOCALE_GREGORIAN ||
+         aLocale == LOCALE_JULIAN) {
+      return 0;
+   }
+   int count = 0;
+   int year, month, day;
+   splitDay(CALENDAR_JULIAN, aLocale, year, month, day);
+   while (!isValidDate(aLocale, year, month, day)) {
+      if (count < size) {
+         years[count]  = year;
+         months[count] = month;
+         days[count]   = day;
+      }
+      count++;
+      stepDate(CALENDAR_JULIAN, 1, year, month, day);
+   }
+   return count;
+}
+
+
+
 //////////////////////////////
 //
 // Calendar::getLocale --
@@ -224,65 +507,90 @@ int Calendar::getLocale(void) const {
 
 //////////////////////////////
 //
-// Calendar::getLocaleName -- returns the locale name of the given
-//     locale code.
+// Calendar::getLocaleByIndex -- returns the locale code for an index
+//     from 0 to getLocaleCount()-1.
 //
 
-const char* Calendar::getLocaleName(int aLocale) {
-   switch (aLocale) {
-      case LOCALE_ROME:
-         return "Rome";
-      case LOCALE_FRANCE:
-         return "France";
-      case LOCALE_ENGLAND:
-         return "England";
-      case LOCALE_UNKNOWN:
-      default:
-         return "Unknown";
+int Calendar::getLocaleByIndex(int index) {
+   if (index < 0 || index >= LOCALE_COUNT) {
+      return LOCALE_UNKNOWN;
    }
+   return localeCode[index];
 }
 
 
 
 //////////////////////////////
 //
-// Calendar::getMonth -- offset from 1 for January, 12=december
+// Calendar::getLocaleByName -- returns the locale code for a locale
+//     name or alias (case insensitive), such as "england" or "uk".
+//     Returns LOCALE_UNKNOWN if the name is not known.
 //
 
-int Calendar::getMonth(int aLocale, int aNiceneDay) {
-   int calendar = getCalendar(aLocale, aNiceneDay);
-   int year = getYear(aLocale, aNiceneDay);
-   
-   int yearNicene = niceneDay(calendar, year, 1, 1);
+int Calendar::getLocaleByName(const char* name) {
+   for (int i=0; localeAlias[i].name != NULL; i++) {
+      if (strcasecmp(name, localeAlias[i].name) == 0) {
+         return localeAlias[i].locale;
+      }
+   }
+   return LOCALE_UNKNOWN;
+}
 
-   int dayofyear = aNiceneDay - yearNicene;
 
-   
-   const int* montharray;
-   if (leapYear(calendar, year)) {
-      montharray = lmonthday;
-   } else {
-      montharray = monthday;
-   }
 
-   int month = 1;
-   while (month < 13 && montharray[month] <= dayofyear) {
-      month++;
-   }
-   month--;
-   if (month == 0) {
-      month = 1;
-   }
-   if (month >= 13) {
-      month = 12;
+//////////////////////////////
+//
+// Calendar::getLocaleCount -- returns the number of known locales.
+//
+
+int Calendar::getLocaleCount(void) {
+   return LOCALE_COUNT;
+}
+
+
+
+//////////////////////////////
+//
+// Calendar::getLocaleIndex -- returns the index of the locale code, or
+//     -1 if the locale is not known.
+//
+
+int Calendar::getLocaleIndex(int aLocale) {
+   for (int i=0; i<LOCALE_COUNT; i++) {
+      if (localeCode[i] == aLocale) {
+         return i;
+      }
    }
+   return -1;
+}
 
-   if (month < 1 || month > 12) {
-      cout << "Error in getMonth() function: " << month << endl;
-      exit(1);
-   } else {
-      return month;
+
+
+//////////////////////////////
+//
+// Calendar::getLocaleName -- returns the locale name of the given
+//     locale code.
+//
+
+const char* Calendar::getLocaleName(int aLocale) {
+   int index = getLocaleIndex(aLocale);
+   if (index < 0) {
+      return "Unknown";
    }
+   return localeName[index];
+}
+
+
+
+//////////////////////////////
+//
+// Calendar::getMonth -- offset from 1 for January, 12=december
+//
+
+int Calendar::getMonth(int aLocale, int aNiceneDay) {
+   int year, month, day;
+   getDate(aLocale, aNiceneDay, year, month, day);
+   return month;
 }
 
 
@@ -299,6 +607,7 @@ int Calendar::getMonth(void) {
 //
 
 int Calendar::getMonthCalendar(void) {
+   TraceSpan span("getMonthCalendar");
    int year = getYear();
    int month = getMonth();
 
@@ -309,18 +618,10 @@ int Calendar::getMonthCalendar(void) {
       return CALENDAR_JULIAN;
    }
   
-   Calendar cal1;
-   Calendar cal2;
-
-   cal1.setDate(year, month, 1, getLocale());
-   if (month == 12) {
-      cal2.setDate(year+1, 1, 1, getLocale());
-   } else {
-      cal2.setDate(year, month+1, 1, getLocale());
-   }
-   
-   int calendar1 = cal1.getCalendar();
-   int calendar2 = cal2.getCalendar();
+   DayCursor cursor(getLocale(), year, month, 1);
+   int calendar1 = cursor.getCalendar();
+   cursor.nextMonth();
+   int calendar2 = cursor.getCalendar();
 
    if (calendar1 == calendar2) {
       return calendar1;
@@ -348,19 +649,9 @@ int Calendar::getNiceneDay(void) const {
 //
 
 int Calendar::getYear(int aLocale, int aNiceneDay) {
-   int calendar = getCalendar(aLocale, aNiceneDay);
-
-   switch (calendar) {
-      case CALENDAR_JULIAN:
-         return (int)((aNiceneDay+72745)/365.25+1);
-         break;
-      case CALENDAR_GREGORIAN:
-         return (int)((aNiceneDay+72743)/365.2425+1);
-         break;
-      default:
-         cout << "Error: unknown calendar type:" << calendar << endl;
-         exit(1);
-   }
+   int year, month, day;
+   getDate(aLocale, aNiceneDay, year, month, day);
+   return year;
 }
 
 
@@ -372,27 +663,28 @@ int Calendar::getYear() {
 
 //////////////////////////////
 //
-// Calendar::getYearCalendar -- returns the calendar type for the current year.
+// Calendar::getYearCalendar -- returns the calendar type for the current year,
+//     or for a year of a locale.
 //
 
 int Calendar::getYearCalendar(void) {
-   int year = getYear();
+   TraceSpan span("getYearCalendar");
+   return getYearCalendar(getLocale(), getYear());
+}
+
 
+int Calendar::getYearCalendar(int aLocale, int year) {
    // handle special case for Protestand Switzerland where Jan 1, 1701 does not exist:
-   if (getLocale() == LOCALE_ZURICH && year == 1701) {
+   if (aLocale == LOCALE_ZURICH && year == 1701) {
       return CALENDAR_REFORMATION;
-   } else if (getLocale() == LOCALE_ZURICH && year == 1700) {
+   } else if (aLocale == LOCALE_ZURICH && year == 1700) {
       return CALENDAR_JULIAN;
    }
 
-   Calendar cal1;
-   Calendar cal2;
-
-   cal1.setDate(year, 1, 1, getLocale());
-   cal2.setDate(year+1, 1, 1, getLocale());
-
-   int calendar1 = cal1.getCalendar();
-   int calendar2 = cal2.getCalendar();
+   DayCursor cursor1(aLocale, year, 1, 1);
+   DayCursor cursor2(aLocale, year+1, 1, 1);
+   int calendar1 = cursor1.getCalendar();
+   int calendar2 = cursor2.getCalendar();
 
    if (calendar1 == calendar2) {
       return calendar1;
@@ -403,6 +695,35 @@ int Calendar::getYearCalendar(void) {
 
 
 
+//////////////////////////////
+//
+// Calendar::isValidDate -- returns true if the date existed in the locale:
+//     the month is 1-12, the day is within the length of the month in the
+//     calendar which the locale used for the date, and the date was not
+//     dropped by the reform of the locale.  Unlike setDate(), which places
+//     a dropped date after the reform, this does not exit on bad months
+//     or days.
+//
+
+int Calendar::isValidDate(int aLocale, int year, int month, int day) {
+   if (month < 1 || month > 12 || day < 1 || day > 31 ||
+         aLocale == LOCALE_UNKNOWN) {
+      return 0;
+   }
+   // the calendar chosen by getCalendar(aLocale, year, month, day):
+   if (gregorianDay(year, month, day) >= aLocale &&
+         aLocale != LOCALE_JULIAN) {
+      return day <= monthLength(CALENDAR_GREGORIAN, year, month);
+   }
+   // a Julian date is dropped if it falls on or after the reform:
+   if (day > monthLength(CALENDAR_JULIAN, year, month)) {
+      return 0;
+   }
+   return aLocale == LOCALE_JULIAN || julianDay(year, month, day) < aLocale;
+}
+
+
+
 //////////////////////////////
 //
 // Calendar::leapYear -- return true if the year is a leap year for the 
@@ -444,17 +765,20 @@ int Calendar::leapYear(int calendar, int year) {
 //
 
 int Calendar::niceneDay(int calendar, int year, int month, int day) {
+   Stats::count(STATS_COUNT_NICENEDAY);
+   HCAL_PROBE4(niceneday__entry, calendar, year, month, day);
    validateMonth(month);
    validateDay(day);
 
+   int output;
    switch (calendar) {
       case CALENDAR_JULIAN:
-         return (year-1)*365 + (year-1)/4 
+         output = (year-1)*365 + (year-1)/4 
               + dayOfYear(calendar, year, month, day)
               - 72744 /* days since 1 Mar 200 */;
          break;
       case CALENDAR_GREGORIAN:
-         return (year-1)*365 + (year-1)/4 
+         output = (year-1)*365 + (year-1)/4 
               - (year-1)/100 + (year-1)/400
               + dayOfYear(calendar, year, month, day)
               - 72742 /* days since 1 Mar 200 */;
@@ -463,6 +787,47 @@ int Calendar::niceneDay(int calendar, int year, int month, int day) {
          cout << "Error: unknown calendar style: " << calendar << endl;
          exit(1);
    }
+   HCAL_PROBE1(niceneday__return, output);
+   return output;
+}
+
+
+//////////////////////////////
+//
+// Calendar::niceneDays -- batch conversion of count dates in the given
+//     locale to Nicene days.  The calendar of each date is chosen in
+//     the same way as setDate().  Months and days are not validated.
+//     Dates in the same month as the previous date are offset from its
+//     Nicene day.  The output array must not overlap the input arrays.
+//
+
+void Calendar::niceneDays(int aLocale, const int* years, const int* months,
+      const int* days, int* output, int count) {
+   Stats::count(STATS_COUNT_NICENEDAY, count);
+   int gregorian = 0;
+   int lastJulian = 0;
+   for (int i=0; i<count; i++) {
+      int delta = 0;
+      int sameMonth = i > 0 && months[i] == months[i-1] &&
+            years[i] == years[i-1];
+      if (sameMonth) {
+         delta = days[i] - days[i-1];
+         gregorian += delta;
+      } else {
+         gregorian = gregorianDay(years[i], months[i], days[i]);
+      }
+      if (gregorian >= aLocale && aLocale != LOCALE_JULIAN) {
+         output[i] = gregorian;
+         lastJulian = 0;
+      } else {
+         if (sameMonth && lastJulian) {
+            output[i] = output[i-1] + delta;
+         } else {
+            output[i] = julianDay(years[i], months[i], days[i]);
+         }
+         lastJulian = 1;
+      }
+   }
 }
 
 
@@ -474,7 +839,8 @@ int Calendar::niceneDay(int calendar, int year, int month, int day) {
 //
 
 ostream& Calendar::printYear(ostream& out, int ttype) { 
-   stringstream s_month[13];
+   TraceSpan span("printYear");
+   char s_month[13][CALENDAR_MONTH_SIZE];
    char str_jan[8 * 21] = {0};
    char str_feb[8 * 21] = {0};
    char str_mar[8 * 21] = {0};
@@ -492,17 +858,17 @@ ostream& Calendar::printYear(ostream& out, int ttype) {
    char yearbuf[32] = {0};
    int year = getYear();
    sprintf(yearbuf, "%d", year);
+   HCAL_PROBE2(render__year__start, year, ttype);
 
    int i;
    int length = 0;
    if (ttype == 1) {
       for (i=1; i<=12; i++) {
-         printMonth(s_month[i], i, 10);
-         s_month[i] << ends;
+         renderMonth(s_month[i], CALENDAR_MONTH_SIZE, i, 10);
       }
       out << centerline(buf, yearbuf, 20, ' ') << '\n';
       for (i=1; i<=12; i++) {
-         strncpy(str_jan, s_month[i].str().c_str(), 8 * 21);
+         strncpy(str_jan, s_month[i], 8 * 21);
          int q;
          for (q=0; q<=length; q++) {
             if (str_jan[q] == '\n') {
@@ -524,21 +890,20 @@ ostream& Calendar::printYear(ostream& out, int ttype) {
       }
    } else {
       for (i=1; i<=12; i++) {
-         printMonth(s_month[i], i, 1);
-         s_month[i] << ends;
-      }
-      strncpy(str_jan, s_month[1].str().c_str(), 8 * 21);
-      strncpy(str_feb, s_month[2].str().c_str(), 8 * 21);
-      strncpy(str_mar, s_month[3].str().c_str(), 8 * 21);
-      strncpy(str_apr, s_month[4].str().c_str(), 8 * 21);
-      strncpy(str_may, s_month[5].str().c_str(), 8 * 21);
-      strncpy(str_jun, s_month[6].str().c_str(), 8 * 21);
-      strncpy(str_jul, s_month[7].str().c_str(), 8 * 21);
-      strncpy(str_aug, s_month[8].str().c_str(), 8 * 21);
-      strncpy(str_sep, s_month[9].str().c_str(), 8 * 21);
-      strncpy(str_oct, s_month[10].str().c_str(), 8 * 21);
-      strncpy(str_nov, s_month[11].str().c_str(), 8 * 21);
-      strncpy(str_dec, s_month[12].str().c_str(), 8 * 21);
+         renderMonth(s_month[i], CALENDAR_MONTH_SIZE, i, 1);
+      }
+      strncpy(str_jan, s_month[1], 8 * 21);
+      strncpy(str_feb, s_month[2], 8 * 21);
+      strncpy(str_mar, s_month[3], 8 * 21);
+      strncpy(str_apr, s_month[4], 8 * 21);
+      strncpy(str_may, s_month[5], 8 * 21);
+      strncpy(str_jun, s_month[6], 8 * 21);
+      strncpy(str_jul, s_month[7], 8 * 21);
+      strncpy(str_aug, s_month[8], 8 * 21);
+      strncpy(str_sep, s_month[9], 8 * 21);
+      strncpy(str_oct, s_month[10], 8 * 21);
+      strncpy(str_nov, s_month[11], 8 * 21);
+      strncpy(str_dec, s_month[12], 8 * 21);
 
       char* string[12];
       string[0] = str_jan;
@@ -599,6 +964,7 @@ ostream& Calendar::printYear(ostream& out, int ttype) {
 
    }
 
+   HCAL_PROBE0(render__year__end);
    return out;
 }
 
@@ -612,6 +978,32 @@ ostream& Calendar::printYear(ostream& out, int ttype) {
 //
 
 ostream& Calendar::printMonth(ostream& out, int aMonth, int style) {
+   char buffer[CALENDAR_MONTH_SIZE];
+   int length = renderMonth(buffer, CALENDAR_MONTH_SIZE, aMonth, style);
+   out.write(buffer, length);
+   return out;
+}
+
+
+
+//////////////////////////////
+//
+// Calendar::renderMonth -- write the current month into a caller
+//   buffer of at least CALENDAR_MONTH_SIZE characters.  Returns the
+//   number of characters written, not counting the terminating null.
+//   No memory is allocated.  With --cache, months which have been
+//   rendered before are copied from the cache.
+//   default values: aMonth = MONTH_UNKNOWN, style = 0
+//
+
+int Calendar::renderMonth(char* buffer, int size, int aMonth, int style) {
+   if (size < CALENDAR_MONTH_SIZE) {
+      if (size > 0) {
+         buffer[0] = '\0';
+      }
+      return 0;
+   }
+
    int year = getYear();
    int month;
    if (aMonth == MONTH_UNKNOWN) {
@@ -619,6 +1011,18 @@ ostream& Calendar::printMonth(ostream& out, int aMonth, int style) {
    } else {
       month = aMonth;
    }
+   TraceSpan span("printMonth", "month", month);
+   HCAL_PROBE3(render__month__start, year, month, style);
+   if (DateCache::isEnabled()) {
+      int length = DateCache::findMonth(getLocale(), year, month, style,
+            buffer);
+      if (length >= 0) {
+         Stats::count(STATS_COUNT_RENDERHIT);
+         HCAL_PROBE1(render__month__end, length);
+         return length;
+      }
+      Stats::count(STATS_COUNT_RENDERMISS);
+   }
 
    char buf[32] = {0};
    char mstring[32] = {0};
@@ -730,14 +1134,15 @@ ostream& Calendar::printMonth(ostream& out, int aMonth, int style) {
          break;
    }
 
+   int pos = 0;
    if (style != 1) {
-      out << centerline(buf, mstring, 20, ' ') << '\n';  
+      pos += sprintf(buffer + pos, "%s\n", centerline(buf, mstring, 20, ' '));
    } else {
-      out << centerline(buf, mstring) << '\n';  
+      pos += sprintf(buffer + pos, "%s\n", centerline(buf, mstring));
    }
      
 
-   out << "Su Mo Tu We Th Fr Sa" << endl;
+   pos += sprintf(buffer + pos, "Su Mo Tu We Th Fr Sa\n");
 
    int calendar = getCalendar(getLocale(), year, month, 1);
    if (month == 2 && leapYear(calendar, year)) {
@@ -747,28 +1152,29 @@ ostream& Calendar::printMonth(ostream& out, int aMonth, int style) {
    int dayofweek = dayOfWeek(calendar, year, month, 1);
 
    if (dayofweek > 0) {
-      out << "  ";
+      pos += sprintf(buffer + pos, "  ");
    }
    for (int i=1; i<dayofweek; i++) {
-      out << "   ";
+      pos += sprintf(buffer + pos, "   ");
    }
 
    int lines = 0;
    int displayColumn = dayofweek;
-   int daze = niceneDay(calendar, year, month, 1);
+   DayCursor cursor(getLocale(), niceneDay(calendar, year, month, 1));
    int counter = 0;
    int onecount = 0;
 
-   int currentDay = getDay(getLocale(), daze);
+   int currentDay;
    int quitflag = 0;
+   int width;
    while (counter < 33 && !quitflag) {
       counter++;
 
-      currentDay = getDay(getLocale(), daze);
+      currentDay = cursor.getDay();
       if (displayColumn == 0) {
-         out.width(2);
+         width = 2;
       } else {
-         out.width(3);
+         width = 3;
       }
       if (currentDay == 0) {
          currentDay = dcount;
@@ -777,15 +1183,15 @@ ostream& Calendar::printMonth(ostream& out, int aMonth, int style) {
          onecount++;
       }
       if (onecount < 2 && currentDay <= dcount) {
-         out << currentDay;
+         pos += sprintf(buffer + pos, "%*d", width, currentDay);
       }
       if (currentDay >= dcount) {
          quitflag = 1;
       }
-      daze++;
+      cursor.nextDay();
 
       if (displayColumn >= 6) {
-         out << endl;
+         buffer[pos++] = '\n';
          lines++;
          displayColumn = 0;
       } else {
@@ -793,10 +1199,15 @@ ostream& Calendar::printMonth(ostream& out, int aMonth, int style) {
       }
    }
    for (int j=lines; j<6; j++) {
-      out << endl;
+      buffer[pos++] = '\n';
+   }
+   buffer[pos] = '\0';
+   if (DateCache::isEnabled()) {
+      DateCache::storeMonth(getLocale(), year, month, style, buffer, pos);
    }
+   HCAL_PROBE1(render__month__end, pos);
       
-   return out;
+   return pos;
 }
 
 
@@ -809,6 +1220,7 @@ ostream& Calendar::printMonth(ostream& out, int aMonth, int style) {
 //
 
 void Calendar::setDate(int year, int month, int day, int aLocale) { 
+   TraceSpan span("setDate");
    int calendar;
    if (aLocale == LOCALE_UNKNOWN) {
       if (getLocale() == LOCALE_UNKNOWN) {
@@ -856,6 +1268,28 @@ void Calendar::setJulianDate(int year, int month, int day) {
 
 
 
+//////////////////////////////
+//
+// Calendar::setDayTable -- convert the Nicene days in a built or opened
+//     table by looking up their records, and the rest with arithmetic.
+//     A NULL table selects the arithmetic engine for all days.  The
+//     table must not be changed while it is in use.
+//
+
+void Calendar::setDayTable(const DayTable* table) {
+   if (table == NULL || table->getRecords() == NULL) {
+      dayTable      = NULL;
+      dayTableFirst = 0;
+      dayTableCount = 0;
+   } else {
+      dayTable      = table->getRecords();
+      dayTableFirst = table->getFirstDay();
+      dayTableCount = (unsigned int)table->getCount();
+   }
+}
+
+
+
 //////////////////////////////
 //
 // Calendar::setLocale -- set the locale of the object.
@@ -866,6 +1300,20 @@ void Calendar::setLocale(int aLocale) {
 }
 
 
+//////////////////////////////
+//
+// Calendar::validDates -- batch form of isValidDate(): set valid[i] to 1
+//     if the date i existed in the locale and to 0 otherwise.
+//
+
+void Calendar::validDates(int aLocale, const int* years, const int* months,
+      const int* days, char* valid, int count) {
+   for (int i=0; i<count; i++) {
+      valid[i] = (char)isValidDate(aLocale, years[i], months[i], days[i]);
+   }
+}
+
+
 ///////////////////////////////////////////////////////////////////////////
 //
 // private functions
@@ -900,6 +1348,158 @@ char* Calendar::centerline(char* buffer, const char* string,
 
 
 
+//////////////////////////////
+//
+// Calendar::gregorianDay -- Nicene day of a Gregorian date, without
+//     validation.
+//
+
+int Calendar::gregorianDay(int year, int month, int day) {
+   const int* montharray = (year % 4 == 0 && (year % 100 != 0 ||
+         year % 400 == 0)) ? lmonthday : monthday;
+   return (year-1)*365 + (year-1)/4 - (year-1)/100 + (year-1)/400
+         + montharray[month] + (day-1) - 72742;
+}
+
+
+
+//////////////////////////////
+//
+// Calendar::julianDay -- Nicene day of a Julian date, without validation.
+//
+
+int Calendar::julianDay(int year, int month, int day) {
+   const int* montharray = (year % 4 == 0) ? lmonthday : monthday;
+   return (year-1)*365 + (year-1)/4 + montharray[month] + (day-1) - 72744;
+}
+
+
+
+//////////////////////////////
+//
+// Calendar::monthLength -- the number of days in a month of the given
+//     calendar.
+//
+
+int Calendar::monthLength(int calendar, int year, int month) {
+   if (month == 12) {
+      return 31;
+   }
+   const int* montharray = leapYear(calendar, year) ? lmonthday : monthday;
+   return montharray[month+1] - montharray[month];
+}
+
+
+
+//////////////////////////////
+//
+// Calendar::splitDay -- convert a Nicene day into a year, month and day
+//     of the given calendar, from the day table if it has the day and
+//     otherwise with integer arithmetic.
+//
+
+void Calendar::splitDay(int calendar, int aNiceneDay, int& year, int& month,
+      int& day) {
+   if (dayTable != NULL) {
+      unsigned int offset = (unsigned int)aNiceneDay -
+            (unsigned int)dayTableFirst;
+      if (offset < dayTableCount) {
+         if (calendar == CALENDAR_JULIAN) {
+            DayTable::getJulian(dayTable[offset], aNiceneDay, year, month,
+                  day);
+         } else {
+            DayTable::getGregorian(dayTable[offset], year, month, day);
+         }
+         return;
+      }
+   }
+
+   int start;
+   int leap;
+   if (calendar == CALENDAR_JULIAN) {
+      int t = aNiceneDay + 72744;         // days since 1 Jan 1 Julian
+      year  = floorDivide(4 * t + 3, 1461) + 1;
+      start = (year-1)*365 + floorDivide(year-1, 4) - 72744;
+      leap  = (year % 4 == 0);
+   } else {
+      int t = aNiceneDay + 72742;         // days since 1 Jan 1 Gregorian
+      int n400 = floorDivide(t, 146097);
+      int r = t - n400 * 146097;
+      int n100 = r / 36524;
+      if (n100 == 4) {
+         n100 = 3;
+      }
+      r -= n100 * 36524;
+      int n4 = r / 1461;
+      r -= n4 * 1461;
+      int n1 = r / 365;
+      if (n1 == 4) {
+         n1 = 3;
+      }
+      year  = 400*n400 + 100*n100 + 4*n4 + n1 + 1;
+      start = t - (r - n1 * 365) - 72742;
+      leap  = (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0));
+   }
+
+   int dayofyear = aNiceneDay - start;
+   const int* montharray = leap ? lmonthday : monthday;
+   month = (dayofyear >> 5) + 1;
+   while (month < 12 && montharray[month+1] <= dayofyear) {
+      month++;
+   }
+   day = dayofyear - montharray[month] + 1;
+}
+
+
+
+//////////////////////////////
+//
+// Calendar::floorDivide -- integer division rounding towards minus
+//     infinity.
+//
+
+int Calendar::floorDivide(int numerator, int denominator) {
+   int quotient = numerator / denominator;
+   if ((numerator % denominator != 0) && ((numerator < 0) != (denominator < 0))) {
+      quotient--;
+   }
+   return quotient;
+}
+
+
+
+//////////////////////////////
+//
+// Calendar::stepDate -- move a date of the given calendar by delta days,
+//     carrying into the month and year.  Used for small deltas, where
+//     only a few iterations are needed.
+//
+
+void Calendar::stepDate(int calendar, int delta, int& year, int& month,
+      int& day) {
+   day += delta;
+   if (day >= 1 && day <= 28) {
+      return;
+   }
+   int length;
+   while (day > (length = monthLength(calendar, year, month))) {
+      day -= length;
+      if (++month > 12) {
+         month = 1;
+         year++;
+      }
+   }
+   while (day < 1) {
+      if (--month < 1) {
+         month = 12;
+         year--;
+      }
+      day += monthLength(calendar, year, month);
+   }
+}
+
+
+
 //////////////////////////////
 //
 // Calendar::validateMonth -- limits month range between 1 and 12.
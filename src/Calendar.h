@@ -25,6 +25,27 @@ using namespace std;
 #define CALENDAR_JULIAN     +999998
 #define CALENDAR_REFORMATION      0
 
+// Buffer size needed by Calendar::renderMonth():
+#define CALENDAR_MONTH_SIZE     256
+
+// Largest gap between Nicene days which Calendar::getDates() steps across
+// from the previous date instead of converting from scratch:
+#define CALENDAR_STEP_LIMIT      62
+
+// Weekday masks for Calendar::countWeekdays(), with bit w set for weekday
+// w (0 = Sunday ... 6 = Saturday):
+#define WEEKDAY_MASK_SUNDAY      0x01
+#define WEEKDAY_MASK_WORKDAYS    0x3e    /* Monday to Friday */
+#define WEEKDAY_MASK_ALL         0x7f
+
+// Largest year accepted by the bulk converters, the joins, the histograms
+// and Easter (keeps Nicene day arithmetic within an int):
+#define CALENDAR_MAX_YEAR        999999
+
+// Array size which holds the dates dropped by any locale's reform, for
+// Calendar::getDroppedDays():
+#define CALENDAR_DROPPED_SIZE    16
+
 
 // These are the first Nicene days on which the Gregorian calendar was adopted
 // for each region.
@@ -45,6 +66,19 @@ using namespace std;
 #define LOCALE_GREECE        629700    /* 10-22 March     1924 dropped      */
 #define LOCALE_TURKEY        630714    /* 19-31 December  1926 dropped      */
 
+// Number of locales known to Calendar::getLocaleByIndex() (including
+// LOCALE_GREGORIAN and LOCALE_JULIAN):
+#define LOCALE_COUNT         15
+
+
+class DayTable;
+
+class LocaleAlias {
+   public:
+      const char*        name;
+      int                locale;
+};
+
 
 
 
@@ -65,6 +99,9 @@ class Calendar {
                                             int aMonth = MONTH_UNKNOWN,
                                             int style = 0);
       ostream&           printYear       (ostream& out = cout, int ttype = 0);
+      int                renderMonth     (char* buffer, int size,
+                                            int aMonth = MONTH_UNKNOWN,
+                                            int style = 0);
       void               setDate         (int year, int month, int day, 
                                              int aLocale = LOCALE_UNKNOWN);
       void               setGregorianDate(int year, int month, int day);
@@ -73,22 +110,80 @@ class Calendar {
     
 
    // static public functions
+      static void        addDays         (int aLocale, int delta, int& year,
+                                               int& month, int& day);
+      static void        addDays         (int aLocale, const int* deltas,
+                                               int* years, int* months,
+                                               int* days, int count);
+      static int         countWeekdays   (int firstDay, int lastDay,
+                                               int weekdayMask);
+      static int         countWeekdays   (int aLocale, int year1, int month1,
+                                               int day1, int year2,
+                                               int month2, int day2,
+                                               int weekdayMask);
+      static void        countWeekdays   (int aLocale, const int* years1,
+                                               const int* months1,
+                                               const int* days1,
+                                               const int* years2,
+                                               const int* months2,
+                                               const int* days2,
+                                               int weekdayMask, int* output,
+                                               int count);
+      static int         daysBetween     (int aLocale, int year1, int month1,
+                                               int day1, int year2,
+                                               int month2, int day2);
+      static void        daysBetween     (int aLocale, const int* years1,
+                                               const int* months1,
+                                               const int* days1,
+                                               const int* years2,
+                                               const int* months2,
+                                               const int* days2,
+                                               int* output, int count);
       static int         daysInYear      (int calendar, int year);
       static int         dayOfWeek       (int calendar, int year, int month, 
                                                int day);
       static int         dayOfYear       (int calendar, int year, int month, 
                                                int day);
+      static int         firstDayFrom    (int aLocale, int year, int month,
+                                               int day);
+      static int         floorDivide     (int numerator, int denominator);
       static int         getCalendar     (int locale, int year, int month, 
                                                int day);
       static int         getCalendar     (int locale, int niceneDay);
       static const char* getCalendarName (int calendar);
+      static void        getDate         (int aLocale, int niceneDay,
+                                               int& year, int& month,
+                                               int& day);
+      static void        getDates        (int aLocale, const int* niceneDays,
+                                               int* years, int* months,
+                                               int* days, int count);
       static int         getDay          (int aLocale, int niceneDay);
+      static int         getDroppedDays  (int aLocale, int* years,
+                                               int* months, int* days,
+                                               int size);
+      static int         getLocaleByIndex(int index);
+      static int         getLocaleByName (const char* name);
+      static int         getLocaleCount  (void);
+      static int         getLocaleIndex  (int aLocale);
       static const char* getLocaleName   (int aLocale);
       static int         getMonth        (int aLocale, int niceneDay);
       static int         getYear         (int aLocale, int niceneDay);
+      static int         getYearCalendar (int aLocale, int year);
+      static int         isValidDate     (int aLocale, int year, int month,
+                                               int day);
       static int         leapYear        (int calendar, int year);
+      static int         monthLength     (int calendar, int year, int month);
       static int         niceneDay       (int calendar, int year, int month, 
                                                int day);
+      static void        niceneDays      (int aLocale, const int* years,
+                                               const int* months,
+                                               const int* days, int* output,
+                                               int count);
+      static void        setDayTable     (const DayTable* table);
+      static void        validDates      (int aLocale, const int* years,
+                                               const int* months,
+                                               const int* days, char* valid,
+                                               int count);
 
    private:
       int                locale;         // locale for calendar determination
@@ -96,6 +191,12 @@ class Calendar {
 
       static char*       centerline      (char* buffer, const char* string,
                                             int sz = 20, char fill = '\n');
+      static int         gregorianDay    (int year, int month, int day);
+      static int         julianDay       (int year, int month, int day);
+      static void        splitDay        (int calendar, int aNiceneDay,
+                                            int& year, int& month, int& day);
+      static void        stepDate        (int calendar, int delta, int& year,
+                                            int& month, int& day);
       static void        validateMonth   (int month);
       static void        validateDay     (int day);
 
@@ -103,6 +204,16 @@ class Calendar {
       static const int   monthday[13];
       static const int   lmonthday[13];
 
+      // records of the table engine (NULL for arithmetic only):
+      static const unsigned int* dayTable;
+      static int                 dayTableFirst;
+      static unsigned int        dayTableCount;
+
+      // locale codes, names and name aliases:
+      static const int         localeCode[LOCALE_COUNT];
+      static const char*       localeName[LOCALE_COUNT];
+      static const LocaleAlias localeAlias[];
+
 };
 
 
@@ -0,0 +1,196 @@
+//
+// Creation Date: Sun Oct 18 18:48:20 PDT 2026
+// Last Modified: Sun Oct 18 18:48:20 PDT 2026
+// Filename:      ColumnarFormat.cpp
+// Syntax:        C++11
+//
+// Description:   Columnar binary format for bulk results (--format
+//                columnar).  See ColumnarFormat.h for the layout.
+//
+
+#include "ByteOrder.h"
+#include "ColumnarFormat.h"
+#include <cstring>
+
+static size_t       alignUp         (size_t value, size_t alignment);
+static void         swapColumn      (int* values, int count);
+
+
+//////////////////////////////
+//
+// ColumnarBlock::ColumnarBlock --
+//
+
+ColumnarBlock::ColumnarBlock(void) {
+   rows     = 0;
+   nicene   = NULL;
+   year     = NULL;
+   month    = NULL;
+   day      = NULL;
+   calendar = NULL;
+   weekday  = NULL;
+}
+
+
+
+//////////////////////////////
+//
+// ColumnarBlock::~ColumnarBlock --
+//
+
+ColumnarBlock::~ColumnarBlock() { }
+
+
+
+//////////////////////////////
+//
+// ColumnarBlock::create -- write the header of a block of rowCount rows
+//     into getSize(rowCount) bytes at block and point the columns into
+//     it.  The caller fills the columns and then calls finish().
+//
+
+void ColumnarBlock::create(char* block, int rowCount) {
+   size_t size = getSize(rowCount);
+   memset(block, 0, COLUMNAR_HEADER_SIZE);
+   memcpy(block, "HCALBLK1", 8);
+   writeUint32(block + 8, (unsigned int)rowCount);
+   writeUint32(block + 12, (unsigned int)size);
+
+   size_t offset = COLUMNAR_HEADER_SIZE;
+   size_t intSize = alignUp((size_t)rowCount * 4, COLUMNAR_HEADER_SIZE);
+   size_t byteSize = alignUp((size_t)rowCount, COLUMNAR_HEADER_SIZE);
+   for (int i=0; i<6; i++) {
+      writeUint32(block + 16 + 4 * i, (unsigned int)offset);
+      offset += i < 4 ? intSize : byteSize;
+   }
+   memset(block + offset, 0, size - offset);
+   view(block, size);
+}
+
+
+
+//////////////////////////////
+//
+// ColumnarBlock::finish -- convert the integer columns to little-endian
+//     order (which does nothing on little-endian hosts).
+//
+
+void ColumnarBlock::finish(void) {
+   if (bigEndianHost()) {
+      swapColumn(nicene, rows);
+      swapColumn(year, rows);
+      swapColumn(month, rows);
+      swapColumn(day, rows);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ColumnarBlock::view -- point the columns into an existing block of
+//     size bytes, such as one in a memory-mapped file.  Returns 0 if the
+//     block is not valid.  The integer columns are used in place, so a
+//     big-endian host has to swap them itself.
+//
+
+int ColumnarBlock::view(char* block, size_t size) {
+   if (size < COLUMNAR_HEADER_SIZE || memcmp(block, "HCALBLK1", 8) != 0) {
+      return 0;
+   }
+   unsigned int rowCount = readUint32(block + 8);
+   if (rowCount > COLUMNAR_BLOCK_ROWS || readUint32(block + 12) > size ||
+         readUint32(block + 12) != getSize((int)rowCount)) {
+      return 0;
+   }
+   rows     = (int)rowCount;
+   nicene   = (int*)(block + readUint32(block + 16));
+   year     = (int*)(block + readUint32(block + 20));
+   month    = (int*)(block + readUint32(block + 24));
+   day      = (int*)(block + readUint32(block + 28));
+   calendar = (unsigned char*)(block + readUint32(block + 32));
+   weekday  = (unsigned char*)(block + readUint32(block + 36));
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// ColumnarBlock::fileHeader -- write the COLUMNAR_ALIGNMENT bytes of
+//     the file header.
+//
+
+void ColumnarBlock::fileHeader(char* header, int aLocale) {
+   memset(header, 0, COLUMNAR_ALIGNMENT);
+   memcpy(header, "HCALCOL1", 8);
+   writeUint32(header + 8, 1);
+   writeUint32(header + 12, COLUMNAR_ALIGNMENT);
+   writeUint32(header + 16, (unsigned int)aLocale);
+}
+
+
+
+//////////////////////////////
+//
+// ColumnarBlock::getSize -- the number of bytes in a block of rowCount
+//     rows (at most COLUMNAR_BLOCK_ROWS).
+//
+
+size_t ColumnarBlock::getSize(int rowCount) {
+   size_t intSize = alignUp((size_t)rowCount * 4, COLUMNAR_HEADER_SIZE);
+   size_t byteSize = alignUp((size_t)rowCount, COLUMNAR_HEADER_SIZE);
+   return alignUp(COLUMNAR_HEADER_SIZE + 4 * intSize + 2 * byteSize,
+         COLUMNAR_ALIGNMENT);
+}
+
+
+
+//////////////////////////////
+//
+// ColumnarBlock::getTotalSize -- the number of bytes in the blocks needed
+//     for rowCount rows, when all but the last are full.
+//
+
+size_t ColumnarBlock::getTotalSize(long long rowCount) {
+   long long full = rowCount / COLUMNAR_BLOCK_ROWS;
+   int rest = (int)(rowCount % COLUMNAR_BLOCK_ROWS);
+   size_t size = (size_t)full * getSize(COLUMNAR_BLOCK_ROWS);
+   if (rest > 0) {
+      size += getSize(rest);
+   }
+   return size;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// alignUp -- round value up to a multiple of alignment.
+//
+
+static size_t alignUp(size_t value, size_t alignment) {
+   return (value + alignment - 1) / alignment * alignment;
+}
+
+
+
+//////////////////////////////
+//
+// swapColumn -- reverse the byte order of count ints.
+//
+
+static void swapColumn(int* values, int count) {
+   for (int i=0; i<count; i++) {
+      unsigned int v = (unsigned int)values[i];
+      values[i] = (int)((v >> 24) | ((v >> 8) & 0xff00) |
+            ((v << 8) & 0xff0000) | (v << 24));
+   }
+}
+
+
+
@@ -0,0 +1,84 @@
+//
+// Creation Date: Sun Oct 18 18:48:20 PDT 2026
+// Last Modified: Sun Oct 18 18:48:20 PDT 2026
+// Filename:      ColumnarFormat.h
+// Syntax:        C++11
+//
+// Description:   Columnar binary format for bulk results (--format
+//                columnar), laid out so that a reader can mmap the file
+//                and use the columns in place.
+//
+// All integers are little-endian.  The file starts with a file header
+// padded to COLUMNAR_ALIGNMENT (4096) bytes:
+//    offset  0  char[8]  "HCALCOL1"
+//    offset  8  uint32   version (1)
+//    offset 12  uint32   alignment (4096)
+//    offset 16  int32    locale of the dates (a LOCALE_* value)
+//    the rest is zero.
+//
+// Blocks follow until the end of the file.  Each block starts at a
+// multiple of the alignment and holds up to COLUMNAR_BLOCK_ROWS rows:
+//    offset  0  char[8]  "HCALBLK1"
+//    offset  8  uint32   number of rows
+//    offset 12  uint32   size of the block in bytes, including this
+//                        header and padding (a multiple of 4096)
+//    offset 16  uint32   offset of the Nicene day column (int32[rows])
+//    offset 20  uint32   offset of the year column       (int32[rows])
+//    offset 24  uint32   offset of the month column      (int32[rows])
+//    offset 28  uint32   offset of the day column        (int32[rows])
+//    offset 32  uint32   offset of the calendar column   (uint8[rows])
+//    offset 36  uint32   offset of the weekday column    (uint8[rows])
+//    the rest of the 64-byte header is zero.
+// Column offsets are from the start of the block and are multiples of 64.
+// Calendar values are 0 = Julian, 1 = Gregorian, or 255 for a row with
+// no date (an unreadable or blank input line), in which case the other
+// columns are zero.  Weekdays are 0 = Sunday to 6 = Saturday.
+//
+
+#ifndef _COLUMNARFORMAT_H_INCLUDED
+#define _COLUMNARFORMAT_H_INCLUDED
+
+#include <cstddef>
+
+// Alignment of the file header and blocks in the file:
+#define COLUMNAR_ALIGNMENT   4096
+
+// Maximum number of rows in a block:
+#define COLUMNAR_BLOCK_ROWS  65536
+
+// Size of the block header and alignment of the columns:
+#define COLUMNAR_HEADER_SIZE 64
+
+// Calendar column values:
+#define COLUMNAR_JULIAN      0
+#define COLUMNAR_GREGORIAN   1
+#define COLUMNAR_NO_DATE     255
+
+
+class ColumnarBlock {
+   public:
+                         ColumnarBlock   (void);
+                        ~ColumnarBlock   ();
+
+      void               create          (char* block, int rowCount);
+      void               finish          (void);
+      int                view            (char* block, size_t size);
+
+      static void        fileHeader      (char* header, int aLocale);
+      static size_t      getSize         (int rowCount);
+      static size_t      getTotalSize    (long long rowCount);
+
+      int                rows;           // number of rows in the block
+      int*               nicene;         // Nicene day column
+      int*               year;           // year column
+      int*               month;          // month column
+      int*               day;            // day column
+      unsigned char*     calendar;       // calendar column
+      unsigned char*     weekday;        // weekday column
+};
+
+
+#endif  // _COLUMNARFORMAT_H_INCLUDED
+
+
+
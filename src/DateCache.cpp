@@ -0,0 +1,287 @@
+//
+// Creation Date: Sun Oct 18 20:14:51 PDT 2026
+// Last Modified: Sun Oct 18 20:14:51 PDT 2026
+// Filename:      DateCache.cpp
+// Syntax:        C++11
+//
+// Description:   Bounded cache of date conversions and rendered months
+//                (--cache).  See DateCache.h.
+//
+
+#include "Calendar.h"
+#include "DateCache.h"
+#include <atomic>
+#include <cstring>
+
+using namespace std;
+
+// Number of slots which a key may be stored in:
+#define DATECACHE_WAYS        4
+
+// Number of 64-bit words holding the text of a rendered month:
+#define DATECACHE_TEXT_WORDS  (CALENDAR_MONTH_SIZE / 8)
+
+// A key hashes to a bucket of DATECACHE_WAYS slots and is looked for in
+// each of them.  A slot is read by checking that its sequence number is even (no write
+// in progress), reading the key and value, and checking that the sequence
+// number has not changed.  A writer makes the number odd while it writes.
+// Slots start at sequence number 0 and are not used until written once.
+// Each slot has its own cache line so that writers do not slow down
+// readers of neighbouring slots.
+
+class alignas(64) ConversionSlot {
+   public:
+      atomic<unsigned int>  sequence;
+      atomic<int>           key[5];       // from, to, year, month, day
+      atomic<int>           value[4];     // Nicene day, year, month, day
+};
+
+class alignas(64) RenderSlot {
+   public:
+      atomic<unsigned int>  sequence;
+      atomic<int>           key[4];       // locale, year, month, style
+      atomic<int>           length;       // characters of text
+      atomic<unsigned long long> text[DATECACHE_TEXT_WORDS];
+};
+
+static ConversionSlot conversions[DATECACHE_CONVERT_SLOTS];
+static RenderSlot     renders[DATECACHE_RENDER_SLOTS];
+
+template <class SLOT>
+static int          chooseWay       (SLOT* ways, unsigned int hash);
+static unsigned int hashKey         (const int* key, int count);
+static int          lockSlot        (atomic<unsigned int>& sequence,
+                                       unsigned int& start);
+
+int DateCache::enabled = 0;
+
+
+//////////////////////////////
+//
+// DateCache::enable -- use the cache from now on.
+//
+
+void DateCache::enable(void) {
+   enabled = 1;
+}
+
+
+
+//////////////////////////////
+//
+// DateCache::findConversion -- look up the conversion of a date from one
+//     locale to another.  Returns true and sets the Nicene day and the
+//     converted date if it is in the cache.
+//
+
+int DateCache::findConversion(int fromLocale, int toLocale, int year,
+      int month, int day, int& nday, int& outYear, int& outMonth,
+      int& outDay) {
+   int key[5] = { fromLocale, toLocale, year, month, day };
+   unsigned int bucket = hashKey(key, 5) &
+         (DATECACHE_CONVERT_SLOTS / DATECACHE_WAYS - 1);
+
+   for (int way=0; way<DATECACHE_WAYS; way++) {
+      ConversionSlot& slot = conversions[bucket * DATECACHE_WAYS + way];
+      unsigned int start = slot.sequence.load(memory_order_acquire);
+      if (start == 0 || (start & 1)) {
+         continue;
+      }
+      int i;
+      int found[5];
+      int value[4];
+      for (i=0; i<5; i++) {
+         found[i] = slot.key[i].load(memory_order_relaxed);
+      }
+      for (i=0; i<4; i++) {
+         value[i] = slot.value[i].load(memory_order_relaxed);
+      }
+      atomic_thread_fence(memory_order_acquire);
+      if (slot.sequence.load(memory_order_relaxed) != start ||
+            memcmp(found, key, sizeof(key)) != 0) {
+         continue;
+      }
+      nday     = value[0];
+      outYear  = value[1];
+      outMonth = value[2];
+      outDay   = value[3];
+      return 1;
+   }
+   return 0;
+}
+
+
+
+//////////////////////////////
+//
+// DateCache::findMonth -- look up a rendered month.  If it is in the
+//     cache, the text is copied into buffer (which must have room for
+//     CALENDAR_MONTH_SIZE characters) and its length is returned,
+//     otherwise -1 is returned.
+//
+
+int DateCache::findMonth(int aLocale, int year, int month, int style,
+      char* buffer) {
+   int key[4] = { aLocale, year, month, style };
+   unsigned int bucket = hashKey(key, 4) &
+         (DATECACHE_RENDER_SLOTS / DATECACHE_WAYS - 1);
+
+   for (int way=0; way<DATECACHE_WAYS; way++) {
+      RenderSlot& slot = renders[bucket * DATECACHE_WAYS + way];
+      unsigned int start = slot.sequence.load(memory_order_acquire);
+      if (start == 0 || (start & 1)) {
+         continue;
+      }
+      int i;
+      int found[4];
+      for (i=0; i<4; i++) {
+         found[i] = slot.key[i].load(memory_order_relaxed);
+      }
+      int length = slot.length.load(memory_order_relaxed);
+      if (memcmp(found, key, sizeof(key)) != 0 || length < 0 ||
+            length >= CALENDAR_MONTH_SIZE) {
+         continue;
+      }
+      int words = (length + 8) / 8;
+      for (i=0; i<words; i++) {
+         unsigned long long word = slot.text[i].load(memory_order_relaxed);
+         memcpy(buffer + 8 * i, &word, 8);
+      }
+      atomic_thread_fence(memory_order_acquire);
+      if (slot.sequence.load(memory_order_relaxed) != start) {
+         continue;
+      }
+      buffer[length] = '\0';
+      return length;
+   }
+   return -1;
+}
+
+
+
+//////////////////////////////
+//
+// DateCache::storeConversion -- add a conversion to the cache.
+//
+
+void DateCache::storeConversion(int fromLocale, int toLocale, int year,
+      int month, int day, int nday, int outYear, int outMonth, int outDay) {
+   int key[5] = { fromLocale, toLocale, year, month, day };
+   int value[4] = { nday, outYear, outMonth, outDay };
+   unsigned int hash = hashKey(key, 5);
+   unsigned int bucket = hash & (DATECACHE_CONVERT_SLOTS / DATECACHE_WAYS - 1);
+   ConversionSlot& slot = conversions[bucket * DATECACHE_WAYS +
+         chooseWay(conversions + bucket * DATECACHE_WAYS, hash)];
+
+   unsigned int start;
+   if (!lockSlot(slot.sequence, start)) {
+      return;
+   }
+   int i;
+   for (i=0; i<5; i++) {
+      slot.key[i].store(key[i], memory_order_relaxed);
+   }
+   for (i=0; i<4; i++) {
+      slot.value[i].store(value[i], memory_order_relaxed);
+   }
+   slot.sequence.store(start + 2, memory_order_release);
+}
+
+
+
+//////////////////////////////
+//
+// DateCache::storeMonth -- add a rendered month of length characters
+//     (less than CALENDAR_MONTH_SIZE) to the cache.
+//
+
+void DateCache::storeMonth(int aLocale, int year, int month, int style,
+      const char* text, int length) {
+   if (length < 0 || length >= CALENDAR_MONTH_SIZE) {
+      return;
+   }
+   int key[4] = { aLocale, year, month, style };
+   unsigned int hash = hashKey(key, 4);
+   unsigned int bucket = hash & (DATECACHE_RENDER_SLOTS / DATECACHE_WAYS - 1);
+   RenderSlot& slot = renders[bucket * DATECACHE_WAYS +
+         chooseWay(renders + bucket * DATECACHE_WAYS, hash)];
+
+   unsigned int start;
+   if (!lockSlot(slot.sequence, start)) {
+      return;
+   }
+   int i;
+   for (i=0; i<4; i++) {
+      slot.key[i].store(key[i], memory_order_relaxed);
+   }
+   slot.length.store(length, memory_order_relaxed);
+   char padded[CALENDAR_MONTH_SIZE] = {0};
+   memcpy(padded, text, length);
+   int words = (length + 8) / 8;
+   for (i=0; i<words; i++) {
+      unsigned long long word;
+      memcpy(&word, padded + 8 * i, 8);
+      slot.text[i].store(word, memory_order_relaxed);
+   }
+   slot.sequence.store(start + 2, memory_order_release);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// chooseWay -- the slot of a bucket to store a new entry in: the first
+//     unused one, otherwise one picked by the hash of the key.
+//
+
+template <class SLOT>
+static int chooseWay(SLOT* ways, unsigned int hash) {
+   for (int way=0; way<DATECACHE_WAYS; way++) {
+      if (ways[way].sequence.load(memory_order_relaxed) == 0) {
+         return way;
+      }
+   }
+   return (int)((hash >> 24) % DATECACHE_WAYS);
+}
+
+
+
+//////////////////////////////
+//
+// hashKey -- mix the integers of a key.
+//
+
+static unsigned int hashKey(const int* key, int count) {
+   unsigned long long hash = 0x9e3779b97f4a7c15ULL;
+   for (int i=0; i<count; i++) {
+      hash = (hash ^ (unsigned int)key[i]) * 0xff51afd7ed558ccdULL;
+      hash ^= hash >> 32;
+   }
+   return (unsigned int)hash;
+}
+
+
+
+//////////////////////////////
+//
+// lockSlot -- make the sequence number of a slot odd before writing it.
+//     Returns false if another thread is writing the slot.  The caller
+//     stores start + 2 when done.
+//
+
+static int lockSlot(atomic<unsigned int>& sequence, unsigned int& start) {
+   start = sequence.load(memory_order_relaxed);
+   if ((start & 1) || !sequence.compare_exchange_strong(start, start + 1,
+         memory_order_acquire, memory_order_relaxed)) {
+      return 0;
+   }
+   atomic_thread_fence(memory_order_release);
+   return 1;
+}
+
+
+
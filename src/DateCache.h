@@ -0,0 +1,69 @@
+//
+// Creation Date: Sun Oct 18 20:14:51 PDT 2026
+// Last Modified: Sun Oct 18 20:14:51 PDT 2026
+// Filename:      DateCache.h
+// Syntax:        C++11
+//
+// Description:   Bounded cache of date conversions and rendered months
+//                shared by all threads of the program (--cache).  Each
+//                table is set-associative: a key hashes to a bucket of a
+//                few slots, and a new entry replaces an older one in a
+//                full bucket.  Every slot has its own sequence lock, so
+//                a lookup takes no lock and a store which finds its slot
+//                busy is skipped.
+//
+// Conversions are keyed by (from locale, to locale, year, month, day),
+// where a locale may also be CALENDAR_JULIAN or CALENDAR_GREGORIAN,
+// and hold the Nicene day and the date in the second locale.  Rendered
+// months are keyed by (locale, year, month, style) and hold the text
+// written by Calendar::renderMonth().
+//
+
+#ifndef _DATECACHE_H_INCLUDED
+#define _DATECACHE_H_INCLUDED
+
+using namespace std;
+
+// Number of slots in each table (powers of two):
+#define DATECACHE_CONVERT_SLOTS  16384
+#define DATECACHE_RENDER_SLOTS    4096
+
+
+class DateCache {
+   public:
+      static void        enable          (void);
+      static int         isEnabled       (void);
+      static int         findConversion  (int fromLocale, int toLocale,
+                                            int year, int month, int day,
+                                            int& nday, int& outYear,
+                                            int& outMonth, int& outDay);
+      static int         findMonth       (int aLocale, int year, int month,
+                                            int style, char* buffer);
+      static void        storeConversion (int fromLocale, int toLocale,
+                                            int year, int month, int day,
+                                            int nday, int outYear,
+                                            int outMonth, int outDay);
+      static void        storeMonth      (int aLocale, int year, int month,
+                                            int style, const char* text,
+                                            int length);
+
+   private:
+      static int         enabled;
+};
+
+
+
+//////////////////////////////
+//
+// DateCache::isEnabled -- returns true if --cache was given.
+//
+
+inline int DateCache::isEnabled(void) {
+   return enabled;
+}
+
+
+#endif  // _DATECACHE_H_INCLUDED
+
+
+
@@ -0,0 +1,307 @@
+//
+// Creation Date: Sun Oct 18 18:05:44 PDT 2026
+// Last Modified: Sun Oct 18 19:32:07 PDT 2026
+// Filename:      DateDump.cpp
+// Syntax:        C++11
+//
+// Description:   Per-day table of a range of dates in a locale (--dump).
+//
+
+#include "Calendar.h"
+#include "ColumnarFormat.h"
+#include "DateDump.h"
+#include "DayCursor.h"
+#include "DeltaStream.h"
+#include "NumberFormat.h"
+#include "Stats.h"
+#include "Trace.h"
+#include "Workers.h"
+#include <atomic>
+#include <cstring>
+#include <strings.h>
+#include <vector>
+
+using namespace std;
+
+// Largest CSV record: ten integers, a calendar name and separators:
+#define DUMP_CSV_SIZE      96
+
+static char*       writeInt32      (char* p, int value);
+
+
+//////////////////////////////
+//
+// DateDump::DateDump --
+//
+
+DateDump::DateDump(void) {
+   locale      = LOCALE_ENGLAND;
+   format      = DUMP_FORMAT_CSV;
+   threadCount = Workers::getDefaultThreadCount();
+}
+
+
+
+//////////////////////////////
+//
+// DateDump::~DateDump --
+//
+
+DateDump::~DateDump() { }
+
+
+
+//////////////////////////////
+//
+// DateDump::dump -- write the records for the Nicene days startDay to
+//     endDay inclusive.  Returns the exit status for the program.  At
+//     most two chunks per thread are held in memory at once.
+//     default value: output = stdout
+//
+
+int DateDump::dump(int startDay, int endDay, FILE* output) {
+   DeltaWriter deltaWriter;
+   if (format == DUMP_FORMAT_DELTA) {
+      deltaWriter.open(output);
+      if (endDay < startDay) {
+         return deltaWriter.close();
+      }
+   }
+   if (endDay < startDay) {
+      return 0;
+   }
+   if (format == DUMP_FORMAT_CSV) {
+      const char* header = "nicene,year,month,day,calendar,weekday,"
+            "julian_year,julian_month,julian_day,"
+            "gregorian_year,gregorian_month,gregorian_day\n";
+      fputs(header, output);
+      Stats::recordWrite(strlen(header));
+   } else if (format == DUMP_FORMAT_COLUMNAR) {
+      char header[COLUMNAR_ALIGNMENT];
+      ColumnarBlock::fileHeader(header, locale);
+      fwrite(header, 1, COLUMNAR_ALIGNMENT, output);
+      Stats::recordWrite(COLUMNAR_ALIGNMENT);
+   }
+
+   long long days = (long long)endDay - startDay + 1;
+   size_t chunkCount = (size_t)((days + DUMP_CHUNK_DAYS - 1) / DUMP_CHUNK_DAYS);
+   vector<string> outputs(chunkCount);
+
+   Workers::runOrdered(threadCount, chunkCount, (size_t)threadCount * 2,
+         "dump", [&](size_t k) {
+      int first = startDay + (int)(k * DUMP_CHUNK_DAYS);
+      int count = DUMP_CHUNK_DAYS;
+      if ((long long)first + count - 1 > endDay) {
+         count = endDay - first + 1;
+      }
+      TraceSpan span("dumpChunk", "chunk", (int)k);
+      formatDays(first, count, outputs[k]);
+   }, [&](size_t k) {
+      // write the chunks in order as they are finished:
+      TraceSpan span("output", "chunk", (int)k);
+      Stats::startPhase(STATS_PHASE_OUTPUT);
+      if (format == DUMP_FORMAT_DELTA) {
+         deltaWriter.write(outputs[k]);
+      } else {
+         fwrite(outputs[k].data(), 1, outputs[k].size(), output);
+      }
+      Stats::recordWrite(outputs[k].size());
+      Stats::stopPhase(STATS_PHASE_OUTPUT);
+      string().swap(outputs[k]);
+   });
+
+   if (format == DUMP_FORMAT_DELTA) {
+      return deltaWriter.close();
+   }
+   fflush(output);
+   return ferror(output) ? 1 : 0;
+}
+
+
+
+//////////////////////////////
+//
+// DateDump::formatDays -- replace output with the records of count days
+//     starting at the Nicene day startDay.
+//
+
+void DateDump::formatDays(int startDay, int count, string& output) {
+   if (format == DUMP_FORMAT_DELTA) {
+      vector<int> ndays(count);
+      for (int i=0; i<count; i++) {
+         ndays[i] = startDay + i;
+      }
+      output.clear();
+      DeltaWriter::encode(&ndays[0], count, output);
+      return;
+   }
+
+   DayCursor local(locale, startDay);
+   if (format == DUMP_FORMAT_COLUMNAR) {
+      output.resize(ColumnarBlock::getTotalSize(count));
+      char* blockStart = &output[0];
+      int row = 0;
+      while (row < count) {
+         int rows = count - row;
+         if (rows > COLUMNAR_BLOCK_ROWS) {
+            rows = COLUMNAR_BLOCK_ROWS;
+         }
+         ColumnarBlock block;
+         block.create(blockStart, rows);
+         for (int i=0; i<rows; i++) {
+            block.nicene[i]   = local.getNiceneDay();
+            block.year[i]     = local.getYear();
+            block.month[i]    = local.getMonth();
+            block.day[i]      = local.getDay();
+            block.calendar[i] = local.getCalendar() == CALENDAR_GREGORIAN ?
+                  COLUMNAR_GREGORIAN : COLUMNAR_JULIAN;
+            block.weekday[i]  = (unsigned char)local.getWeekday();
+            local.nextDay();
+         }
+         block.finish();
+         blockStart += ColumnarBlock::getSize(rows);
+         row += rows;
+      }
+      return;
+   }
+
+   DayCursor julian(LOCALE_JULIAN, startDay);
+   DayCursor gregorian(LOCALE_GREGORIAN, startDay);
+
+   int recordSize = format == DUMP_FORMAT_BINARY ? DUMP_RECORD_SIZE :
+         DUMP_CSV_SIZE;
+   output.resize((size_t)count * recordSize);
+   char* p = &output[0];
+   for (int i=0; i<count; i++) {
+      int gregorianQ = local.getCalendar() == CALENDAR_GREGORIAN;
+      if (format == DUMP_FORMAT_BINARY) {
+         p = writeInt32(p, local.getNiceneDay());
+         p = writeInt32(p, local.getYear());
+         *p++ = (char)local.getMonth();
+         *p++ = (char)local.getDay();
+         *p++ = (char)gregorianQ;
+         *p++ = (char)local.getWeekday();
+         p = writeInt32(p, julian.getYear());
+         p = writeInt32(p, gregorian.getYear());
+         *p++ = (char)julian.getMonth();
+         *p++ = (char)julian.getDay();
+         *p++ = (char)gregorian.getMonth();
+         *p++ = (char)gregorian.getDay();
+      } else {
+         p = writeInt(p, local.getNiceneDay());
+         *p++ = ',';
+         p = writeInt(p, local.getYear());
+         *p++ = ',';
+         p = writeInt(p, local.getMonth());
+         *p++ = ',';
+         p = writeInt(p, local.getDay());
+         *p++ = ',';
+         const char* name = gregorianQ ? "Gregorian" : "Julian";
+         while (*name != '\0') {
+            *p++ = *name++;
+         }
+         *p++ = ',';
+         *p++ = (char)('0' + local.getWeekday());
+         *p++ = ',';
+         p = writeInt(p, julian.getYear());
+         *p++ = ',';
+         p = writeInt(p, julian.getMonth());
+         *p++ = ',';
+         p = writeInt(p, julian.getDay());
+         *p++ = ',';
+         p = writeInt(p, gregorian.getYear());
+         *p++ = ',';
+         p = writeInt(p, gregorian.getMonth());
+         *p++ = ',';
+         p = writeInt(p, gregorian.getDay());
+         *p++ = '\n';
+      }
+      local.nextDay();
+      julian.nextDay();
+      gregorian.nextDay();
+   }
+   output.resize(p - &output[0]);
+}
+
+
+
+//////////////////////////////
+//
+// DateDump::getFormatByName -- returns the format for "csv", "binary",
+//     "columnar" or "delta", or DUMP_FORMAT_UNKNOWN.
+//
+
+int DateDump::getFormatByName(const char* name) {
+   if (strcasecmp(name, "csv") == 0) {
+      return DUMP_FORMAT_CSV;
+   } else if (strcasecmp(name, "binary") == 0) {
+      return DUMP_FORMAT_BINARY;
+   } else if (strcasecmp(name, "columnar") == 0) {
+      return DUMP_FORMAT_COLUMNAR;
+   } else if (strcasecmp(name, "delta") == 0) {
+      return DUMP_FORMAT_DELTA;
+   }
+   return DUMP_FORMAT_UNKNOWN;
+}
+
+
+
+//////////////////////////////
+//
+// DateDump::setFormat --
+//
+
+void DateDump::setFormat(int aFormat) {
+   format = aFormat;
+}
+
+
+
+//////////////////////////////
+//
+// DateDump::setLocale --
+//
+
+void DateDump::setLocale(int aLocale) {
+   locale = aLocale;
+}
+
+
+
+//////////////////////////////
+//
+// DateDump::setThreadCount -- set the number of worker threads, or the
+//     number of hardware threads if count is less than 1.
+//
+
+void DateDump::setThreadCount(int count) {
+   if (count < 1) {
+      threadCount = Workers::getDefaultThreadCount();
+   } else {
+      threadCount = count;
+   }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// writeInt32 -- write a 32-bit little-endian integer and return a pointer
+//     after it.
+//
+
+static char* writeInt32(char* p, int value) {
+   unsigned int number = value;
+   p[0] = (char)(number & 0xff);
+   p[1] = (char)((number >> 8) & 0xff);
+   p[2] = (char)((number >> 16) & 0xff);
+   p[3] = (char)((number >> 24) & 0xff);
+   return p + 4;
+}
+
+
+
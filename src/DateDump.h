@@ -0,0 +1,92 @@
+//
+// Creation Date: Sun Oct 18 18:05:44 PDT 2026
+// Last Modified: Sun Oct 18 19:32:07 PDT 2026
+// Filename:      DateDump.h
+// Syntax:        C++11
+//
+// Description:   Per-day table of a range of dates in a locale (--dump).
+//                The range is split into chunks of days which worker
+//                threads fill with DayCursor walks; the chunks are written
+//                in order with one write each.
+//
+// Each record describes one day: the Nicene day, the year, month and day
+// in the locale, the calendar in use, the weekday (0 = Sunday), and the
+// same day in the Julian and proleptic Gregorian calendars.
+//
+// DUMP_FORMAT_CSV writes a header line followed by one line per day:
+//    nicene,year,month,day,calendar,weekday,julian_year,julian_month,
+//    julian_day,gregorian_year,gregorian_month,gregorian_day
+// where calendar is "Julian" or "Gregorian".
+//
+// DUMP_FORMAT_BINARY writes DUMP_RECORD_SIZE (24) bytes per day with no
+// header, integers little-endian:
+//    offset  0  int32  Nicene day
+//    offset  4  int32  year
+//    offset  8  uint8  month
+//    offset  9  uint8  day
+//    offset 10  uint8  calendar (0 = Julian, 1 = Gregorian)
+//    offset 11  uint8  weekday (0 = Sunday)
+//    offset 12  int32  Julian year
+//    offset 16  int32  Gregorian year
+//    offset 20  uint8  Julian month
+//    offset 21  uint8  Julian day
+//    offset 22  uint8  Gregorian month
+//    offset 23  uint8  Gregorian day
+//
+// DUMP_FORMAT_COLUMNAR writes the Nicene day, year, month, day, calendar
+// and weekday in the locale as columnar blocks (see ColumnarFormat.h),
+// one block per chunk of days.  The Julian and Gregorian equivalents are
+// not included.
+//
+// DUMP_FORMAT_DELTA writes only the Nicene days, as a delta stream (see
+// DeltaStream.h), which can be converted again with --convert-file.
+//
+
+#ifndef _DATEDUMP_H_INCLUDED
+#define _DATEDUMP_H_INCLUDED
+
+#include <cstdio>
+#include <string>
+
+using namespace std;
+
+// Output formats:
+#define DUMP_FORMAT_UNKNOWN  -1
+#define DUMP_FORMAT_CSV       0
+#define DUMP_FORMAT_BINARY    1
+#define DUMP_FORMAT_COLUMNAR  2
+#define DUMP_FORMAT_DELTA     3
+
+// Bytes per record in DUMP_FORMAT_BINARY:
+#define DUMP_RECORD_SIZE     24
+
+// Number of days formatted by a worker thread at a time:
+#define DUMP_CHUNK_DAYS      16384
+
+
+class DateDump {
+   public:
+                         DateDump        (void);
+                        ~DateDump        ();
+
+      int                dump            (int startDay, int endDay,
+                                            FILE* output = stdout);
+      void               formatDays      (int startDay, int count,
+                                            string& output);
+      void               setFormat       (int aFormat);
+      void               setLocale       (int aLocale);
+      void               setThreadCount  (int count);
+
+      static int         getFormatByName (const char* name);
+
+   private:
+      int                locale;         // locale of the dates
+      int                format;         // DUMP_FORMAT_CSV, _BINARY, etc.
+      int                threadCount;    // number of worker threads
+};
+
+
+#endif  // _DATEDUMP_H_INCLUDED
+
+
+
@@ -0,0 +1,420 @@
+//
+// Creation Date: Sun Oct 18 23:06:40 PDT 2026
+// Last Modified: Sun Oct 18 23:06:40 PDT 2026
+// Filename:      DateHistogram.cpp
+// Syntax:        C++11
+//
+// Description:   Counts of dated events per week, month or year of a
+//                target locale.  See DateHistogram.h.
+//
+
+#include "BulkConverter.h"
+#include "Calendar.h"
+#include "DateHistogram.h"
+#include "DateParser.h"
+#include "NumberFormat.h"
+#include "Stats.h"
+#include "Trace.h"
+#include "Workers.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Chunks smaller than this are not split further between threads:
+#define HISTOGRAM_MIN_CHUNK    (1 << 20)
+
+
+//////////////////////////////
+//
+// DateHistogram::DateHistogram --
+//
+
+DateHistogram::DateHistogram(void) {
+   bucket      = HISTOGRAM_BUCKET_MONTH;
+   toLocale    = LOCALE_GREGORIAN;
+   threadCount = Workers::getDefaultThreadCount();
+   firstKey    = 0;
+   keyCount    = 0;
+}
+
+
+
+//////////////////////////////
+//
+// DateHistogram::~DateHistogram --
+//
+
+DateHistogram::~DateHistogram() { }
+
+
+
+//////////////////////////////
+//
+// DateHistogram::countFile -- count the dates of a file, which are in the
+//     given locale.  Returns 0 (after printing an error) if the file
+//     cannot be read.
+//
+
+int DateHistogram::countFile(const string& filename, int aLocale) {
+   if (counters.empty()) {
+      reset();
+   }
+   int fd = open(filename.c_str(), O_RDONLY);
+   if (fd < 0) {
+      cerr << "Error: cannot open " << filename << ": " << strerror(errno)
+           << endl;
+      return 0;
+   }
+   struct stat info;
+   if (fstat(fd, &info) != 0) {
+      cerr << "Error: cannot read " << filename << endl;
+      close(fd);
+      return 0;
+   }
+   size_t size = info.st_size;
+   if (size == 0) {
+      close(fd);
+      return 1;
+   }
+   void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (mapping == MAP_FAILED) {
+      cerr << "Error: cannot map " << filename << ": " << strerror(errno)
+           << endl;
+      return 0;
+   }
+   madvise(mapping, size, MADV_SEQUENTIAL);
+   const char* data = (const char*)mapping;
+
+   size_t chunkCount = (size_t)threadCount * 4;
+   if (chunkCount > size / HISTOGRAM_MIN_CHUNK + 1) {
+      chunkCount = size / HISTOGRAM_MIN_CHUNK + 1;
+   }
+   vector<const char*> bounds(chunkCount + 1);
+   bounds[0] = data;
+   for (size_t k=1; k<chunkCount; k++) {
+      const char* p = data + size / chunkCount * k;
+      if (p < bounds[k-1]) {
+         p = bounds[k-1];
+      }
+      const char* newline = (const char*)memchr(p, '\n', data + size - p);
+      bounds[k] = newline ? newline + 1 : data + size;
+   }
+   bounds[chunkCount] = data + size;
+
+   atomic<size_t> next(0);
+   int workerCount = threadCount;
+   if ((size_t)workerCount > chunkCount) {
+      workerCount = (int)chunkCount;
+   }
+   Workers::run(workerCount, [&](int t) {
+      size_t k;
+      while ((k = next++) < chunkCount) {
+         TraceSpan span("histogramChunk", "chunk", (int)k);
+         countText(bounds[k], bounds[k+1], aLocale, counters[t]);
+      }
+   }, "histogram");
+   munmap(mapping, size);
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// DateHistogram::getBucketByName -- HISTOGRAM_BUCKET_WEEK for "week", etc.,
+//     or HISTOGRAM_BUCKET_UNKNOWN.
+//
+
+int DateHistogram::getBucketByName(const char* name) {
+   if (strcmp(name, "week") == 0) {
+      return HISTOGRAM_BUCKET_WEEK;
+   } else if (strcmp(name, "month") == 0) {
+      return HISTOGRAM_BUCKET_MONTH;
+   } else if (strcmp(name, "year") == 0) {
+      return HISTOGRAM_BUCKET_YEAR;
+   }
+   return HISTOGRAM_BUCKET_UNKNOWN;
+}
+
+
+
+//////////////////////////////
+//
+// DateHistogram::setBucket -- HISTOGRAM_BUCKET_WEEK, _MONTH or _YEAR.  Set
+//     before counting.
+//
+
+void DateHistogram::setBucket(int aBucket) {
+   bucket = aBucket;
+   counters.clear();
+}
+
+
+
+//////////////////////////////
+//
+// DateHistogram::setThreadCount -- set the number of worker threads, or
+//     the number of hardware threads if count is less than 1.  Set before
+//     counting.
+//
+
+void DateHistogram::setThreadCount(int count) {
+   if (count < 1) {
+      count = Workers::getDefaultThreadCount();
+   }
+   threadCount = count;
+   counters.clear();
+}
+
+
+
+//////////////////////////////
+//
+// DateHistogram::setToLocale -- the locale of the buckets.  Set before
+//     counting.
+//
+
+void DateHistogram::setToLocale(int aLocale) {
+   toLocale = aLocale;
+   counters.clear();
+}
+
+
+
+//////////////////////////////
+//
+// DateHistogram::write -- add the counts of the threads together and
+//     write them to output.  Returns the exit status for the program.
+//     default value: output = stdout
+//
+
+int DateHistogram::write(FILE* output) {
+   if (counters.empty()) {
+      reset();
+   }
+   TraceSpan span("histogramWrite");
+   vector<long long> dense(keyCount, 0);
+   map<long long, long long> sparse;
+   long long skipped = 0;
+   for (size_t t=0; t<counters.size(); t++) {
+      for (long long k=0; k<keyCount; k++) {
+         dense[k] += counters[t].dense[k];
+      }
+      for (auto& entry : counters[t].sparse) {
+         sparse[entry.first] += entry.second;
+      }
+      skipped += counters[t].skipped;
+   }
+   long long first = 0;
+   while (first < keyCount && dense[first] == 0) {
+      first++;
+   }
+   long long last = keyCount - 1;
+   while (last >= first && dense[last] == 0) {
+      last--;
+   }
+
+   // keys in order: sparse keys below the dense range, the dense range,
+   // then sparse keys above it:
+   vector<pair<long long, long long> > rows;
+   for (auto& entry : sparse) {
+      if (entry.first < firstKey) {
+         rows.push_back(entry);
+      }
+   }
+   for (long long k=first; k<=last; k++) {
+      rows.push_back(make_pair(firstKey + k, dense[k]));
+   }
+   for (auto& entry : sparse) {
+      if (entry.first >= firstKey + keyCount) {
+         rows.push_back(entry);
+      }
+   }
+
+   string buffer;
+   char text[64];
+   for (size_t i=0; i<rows.size(); i++) {
+      int start = getBucketStart(rows[i].first);
+      int days = getBucketStart(rows[i].first + 1) - start;
+      int year, month, day;
+      Calendar::getDate(toLocale, start, year, month, day);
+      char* p;
+      if (bucket == HISTOGRAM_BUCKET_WEEK) {
+         p = writeDate(text, year, month, day);
+      } else if (bucket == HISTOGRAM_BUCKET_MONTH) {
+         p = writePadded(text, year, 4);
+         *p++ = '-';
+         p = writePadded(p, month, 2);
+      } else {
+         p = writePadded(text, year, 4);
+      }
+      *p++ = '\t';
+      p = writeInt(p, rows[i].second);
+      *p++ = '\t';
+      p = writeInt(p, days);
+      *p++ = '\n';
+      buffer.append(text, p - text);
+   }
+   fwrite(buffer.data(), 1, buffer.size(), output);
+   Stats::recordWrite(buffer.size());
+   counters.clear();
+
+   if (skipped > 0) {
+      cerr << "Warning: " << skipped << " lines without a date were not "
+              "counted" << endl;
+   }
+   if (fflush(output) != 0 || ferror(output)) {
+      cerr << "Error: cannot write the output" << endl;
+      return 1;
+   }
+   return 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// DateHistogram::countText -- count the dates of the lines between start
+//     and end.  The dates are converted to Nicene days, and for months
+//     and years to dates of the target locale, a block at a time.
+//
+
+void DateHistogram::countText(const char* start, const char* end,
+      int fromLocale, Counter& counter) {
+   int years[BULK_BLOCK_SIZE];
+   int months[BULK_BLOCK_SIZE];
+   int days[BULK_BLOCK_SIZE];
+   int ndays[BULK_BLOCK_SIZE];
+   int toYears[BULK_BLOCK_SIZE];
+   int toMonths[BULK_BLOCK_SIZE];
+   int toDays[BULK_BLOCK_SIZE];
+   const char* p = start;
+   while (p < end) {
+      int count = 0;
+      while (count < BULK_BLOCK_SIZE && p < end) {
+         const char* eol = (const char*)memchr(p, '\n', end - p);
+         if (eol == NULL) {
+            eol = end;
+         }
+         while (p < eol && (*p == ' ' || *p == '\t' || *p == '\r')) {
+            p++;
+         }
+         const char* field = (const char*)memchr(p, '\t', eol - p);
+         if (field == NULL) {
+            field = eol;
+         }
+         int year, month, day;
+         if (p == eol) {
+            // blank line
+         } else if (!DateParser::parse(p, field, year, month, day) ||
+               year > CALENDAR_MAX_YEAR) {
+            counter.skipped++;
+         } else {
+            years[count]  = year;
+            months[count] = month;
+            days[count]   = day;
+            count++;
+         }
+         p = eol + 1;
+      }
+
+      Calendar::niceneDays(fromLocale, years, months, days, ndays, count);
+      if (bucket != HISTOGRAM_BUCKET_WEEK) {
+         Calendar::getDates(toLocale, ndays, toYears, toMonths, toDays,
+               count);
+      }
+      for (int i=0; i<count; i++) {
+         long long key;
+         if (bucket == HISTOGRAM_BUCKET_WEEK) {
+            key = getKey(ndays[i], 0, 0);
+         } else {
+            key = getKey(ndays[i], toYears[i], toMonths[i]);
+         }
+         if (key >= firstKey && key < firstKey + keyCount) {
+            counter.dense[key - firstKey]++;
+         } else {
+            counter.sparse[key]++;
+         }
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DateHistogram::getBucketStart -- the first Nicene day of a bucket.
+//
+
+int DateHistogram::getBucketStart(long long key) const {
+   if (bucket == HISTOGRAM_BUCKET_WEEK) {
+      return (int)(key * 7 + 1);
+   } else if (bucket == HISTOGRAM_BUCKET_MONTH) {
+      int year = Calendar::floorDivide((int)key, 12);
+      return Calendar::firstDayFrom(toLocale, year,
+            (int)key - year * 12 + 1, 1);
+   }
+   return Calendar::firstDayFrom(toLocale, (int)key, 1, 1);
+}
+
+
+
+//////////////////////////////
+//
+// DateHistogram::getKey -- the bucket of a Nicene day, whose date in the
+//     target locale has the given year and month (not needed for weeks).
+//     Weeks are counted from Nicene day 1, which is a Sunday.
+//
+
+long long DateHistogram::getKey(int niceneDay, int year, int month) const {
+   if (bucket == HISTOGRAM_BUCKET_WEEK) {
+      return Calendar::floorDivide(niceneDay - 1, 7);
+   } else if (bucket == HISTOGRAM_BUCKET_MONTH) {
+      return (long long)year * 12 + month - 1;
+   }
+   return year;
+}
+
+
+
+//////////////////////////////
+//
+// DateHistogram::reset -- make empty counters for the worker threads, with
+//     arrays for the keys of the years HISTOGRAM_FIRST_YEAR to
+//     HISTOGRAM_LAST_YEAR.
+//
+
+void DateHistogram::reset(void) {
+   int firstDay = Calendar::firstDayFrom(toLocale, HISTOGRAM_FIRST_YEAR,
+         1, 1);
+   int lastDay = Calendar::firstDayFrom(toLocale, HISTOGRAM_LAST_YEAR + 1,
+         1, 1) - 1;
+   if (bucket == HISTOGRAM_BUCKET_WEEK) {
+      firstKey = getKey(firstDay, 0, 0);
+      keyCount = getKey(lastDay, 0, 0) - firstKey + 1;
+   } else {
+      firstKey = getKey(0, HISTOGRAM_FIRST_YEAR, 1);
+      keyCount = getKey(0, HISTOGRAM_LAST_YEAR, 12) - firstKey + 1;
+   }
+   counters.resize(threadCount);
+   for (size_t t=0; t<counters.size(); t++) {
+      counters[t].dense.assign(keyCount, 0);
+      counters[t].sparse.clear();
+      counters[t].skipped = 0;
+   }
+}
+
+
+
@@ -0,0 +1,87 @@
+//
+// Creation Date: Sun Oct 18 23:06:40 PDT 2026
+// Last Modified: Sun Oct 18 23:06:40 PDT 2026
+// Filename:      DateHistogram.h
+// Syntax:        C++11
+//
+// Description:   Counts of dated events per week, month or year of a
+//                target locale (--histogram).  Files of records (a date,
+//                then optionally a tab and more fields, on each line) are
+//                memory mapped and split into newline-aligned chunks.
+//                Worker threads convert the dates of the chunks with the
+//                Calendar batch functions and count them in counters of
+//                their own, which are added together when the counts are
+//                written.
+//
+// Each output line is "bucket <tab> count <tab> days", where the bucket
+// is the first day of a week (YYYY-MM-DD, weeks start on Sunday), a month
+// (YYYY-MM) or a year (YYYY) in the target locale, and days is the number
+// of days in the bucket.  The days of a month or year which was shortened
+// by a calendar reform are left out, so September 1752 in England has 19
+// days.  Buckets with no events between the first and the last ones of the
+// years HISTOGRAM_FIRST_YEAR to HISTOGRAM_LAST_YEAR are written with a
+// count of 0.
+//
+
+#ifndef _DATEHISTOGRAM_H_INCLUDED
+#define _DATEHISTOGRAM_H_INCLUDED
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Bucket sizes:
+#define HISTOGRAM_BUCKET_UNKNOWN  -1
+#define HISTOGRAM_BUCKET_WEEK      0
+#define HISTOGRAM_BUCKET_MONTH     1
+#define HISTOGRAM_BUCKET_YEAR      2
+
+// Years counted in arrays (counts of other years are kept in maps):
+#define HISTOGRAM_FIRST_YEAR       0
+#define HISTOGRAM_LAST_YEAR        9999
+
+
+class DateHistogram {
+   public:
+                         DateHistogram   (void);
+                        ~DateHistogram   ();
+
+      int                countFile       (const string& filename,
+                                            int aLocale);
+      void               setBucket       (int aBucket);
+      void               setThreadCount  (int count);
+      void               setToLocale     (int aLocale);
+      int                write           (FILE* output = stdout);
+
+      static int         getBucketByName (const char* name);
+
+   private:
+      struct Counter {
+         vector<long long> dense;        // counts of keys from firstKey
+         map<long long, long long> sparse;  // counts of other keys
+         long long       skipped;        // lines without a date
+      };
+
+      int                bucket;         // HISTOGRAM_BUCKET_WEEK, etc.
+      int                toLocale;       // locale of the buckets
+      int                threadCount;    // number of worker threads
+      long long          firstKey;       // key of dense[0]
+      long long          keyCount;       // size of dense
+      vector<Counter>    counters;       // one for each worker thread
+
+      void               countText       (const char* start, const char* end,
+                                            int fromLocale, Counter& counter);
+      int                getBucketStart  (long long key) const;
+      long long          getKey          (int niceneDay, int year,
+                                            int month) const;
+      void               reset           (void);
+};
+
+
+#endif  // _DATEHISTOGRAM_H_INCLUDED
+
+
+
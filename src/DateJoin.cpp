@@ -0,0 +1,529 @@
+//
+// Creation Date: Sun Oct 18 22:41:05 PDT 2026
+// Last Modified: Sun Oct 18 22:41:05 PDT 2026
+// Filename:      DateJoin.cpp
+// Syntax:        C++11
+//
+// Description:   Merge-join of files of dated records from different
+//                locales.  See DateJoin.h.
+//
+
+#include "BulkConverter.h"
+#include "Calendar.h"
+#include "DateJoin.h"
+#include "DateParser.h"
+#include "NumberFormat.h"
+#include "Stats.h"
+#include "Trace.h"
+#include "Workers.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Number of records sorted per thread below which fewer threads are used:
+#define DATEJOIN_MIN_SORT     (1 << 16)
+
+// Size of the output buffer written at once:
+#define DATEJOIN_WRITE_SIZE   (1 << 20)
+
+// Number of items ahead whose lines are fetched while writing:
+#define DATEJOIN_PREFETCH     16
+
+// Item of a line without a date, removed before sorting:
+#define DATEJOIN_NO_DATE      0xffffffffffffffffULL
+
+
+//////////////////////////////
+//
+// DateJoin::DateJoin --
+//
+
+DateJoin::DateJoin(void) {
+   mode        = DATEJOIN_MODE_MERGE;
+   toLocale    = LOCALE_GREGORIAN;
+   threadCount = Workers::getDefaultThreadCount();
+}
+
+
+
+//////////////////////////////
+//
+// DateJoin::~DateJoin --
+//
+
+DateJoin::~DateJoin() {
+   for (size_t i=0; i<streams.size(); i++) {
+      if (streams[i].mapping != NULL) {
+         munmap(streams[i].mapping, streams[i].size);
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DateJoin::addFile -- add a stream of records whose dates are in the
+//     given locale.  Returns 0 (after printing an error) if the file
+//     cannot be read.
+//
+
+int DateJoin::addFile(const string& filename, int aLocale) {
+   int fd = open(filename.c_str(), O_RDONLY);
+   if (fd < 0) {
+      cerr << "Error: cannot open " << filename << ": " << strerror(errno)
+           << endl;
+      return 0;
+   }
+   struct stat info;
+   if (fstat(fd, &info) != 0) {
+      cerr << "Error: cannot read " << filename << endl;
+      close(fd);
+      return 0;
+   }
+   Stream stream;
+   stream.name    = filename;
+   stream.locale  = aLocale;
+   stream.data    = "";
+   stream.size    = info.st_size;
+   stream.mapping = NULL;
+   stream.first   = lines.size();
+   if (stream.size > 0) {
+      void* map = mmap(NULL, stream.size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (map == MAP_FAILED) {
+         cerr << "Error: cannot map " << filename << ": " << strerror(errno)
+              << endl;
+         close(fd);
+         return 0;
+      }
+      madvise(map, stream.size, MADV_SEQUENTIAL);
+      stream.mapping = map;
+      stream.data = (const char*)map;
+   }
+   close(fd);
+
+   const char* p = stream.data;
+   const char* end = stream.data + stream.size;
+   while (p < end) {
+      lines.push_back(p);
+      const char* eol = (const char*)memchr(p, '\n', end - p);
+      p = eol ? eol + 1 : end;
+   }
+   streams.push_back(stream);
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// DateJoin::getModeByName -- DATEJOIN_MODE_MERGE for "merge", etc., or
+//     DATEJOIN_MODE_UNKNOWN.
+//
+
+int DateJoin::getModeByName(const char* name) {
+   if (strcmp(name, "merge") == 0) {
+      return DATEJOIN_MODE_MERGE;
+   } else if (strcmp(name, "inner") == 0) {
+      return DATEJOIN_MODE_INNER;
+   } else if (strcmp(name, "aligned") == 0) {
+      return DATEJOIN_MODE_ALIGNED;
+   }
+   return DATEJOIN_MODE_UNKNOWN;
+}
+
+
+
+//////////////////////////////
+//
+// DateJoin::join -- sort the records of all streams by day and write
+//     them to output.  Returns the exit status for the program.
+//     default value: output = stdout
+//
+
+int DateJoin::join(FILE* output) {
+   if (lines.size() >= 0xffffffffULL) {
+      cerr << "Error: too many records to join" << endl;
+      return 1;
+   }
+   vector<unsigned long long> items;
+   long long skipped = normalize(items);
+   sortByDay(items, threadCount);
+   writeRecords(items, output);
+   if (skipped > 0) {
+      cerr << "Warning: " << skipped << " lines without a date were left "
+              "out of the join" << endl;
+   }
+   if (fflush(output) != 0 || ferror(output)) {
+      cerr << "Error: cannot write the output" << endl;
+      return 1;
+   }
+   return 0;
+}
+
+
+
+//////////////////////////////
+//
+// DateJoin::setMode -- DATEJOIN_MODE_MERGE, _INNER or _ALIGNED.
+//
+
+void DateJoin::setMode(int aMode) {
+   mode = aMode;
+}
+
+
+
+//////////////////////////////
+//
+// DateJoin::setThreadCount -- set the number of worker threads, or the
+//     number of hardware threads if count is less than 1.
+//
+
+void DateJoin::setThreadCount(int count) {
+   if (count < 1) {
+      count = Workers::getDefaultThreadCount();
+   }
+   threadCount = count;
+}
+
+
+
+//////////////////////////////
+//
+// DateJoin::setToLocale -- the locale of the dates written out.
+//
+
+void DateJoin::setToLocale(int aLocale) {
+   toLocale = aLocale;
+}
+
+
+
+//////////////////////////////
+//
+// DateJoin::sortByDay -- sort join items, each holding the Nicene day in
+//     its high 32 bits (offset so that unsigned order is day order) and
+//     the line index in its low 32 bits, by day.  The sort is a least
+//     significant digit radix sort of the day, one byte per pass: every
+//     thread counts the digits of its share of the items, and then moves
+//     its share to the places given by the counts of all threads, so the
+//     sort is stable and items of the same day stay in line order.  A pass
+//     is skipped when all items have the same digit, which is usual for
+//     the top byte.
+//
+
+void DateJoin::sortByDay(vector<unsigned long long>& items,
+      int threadCount) {
+   size_t count = items.size();
+   if (count < 2) {
+      return;
+   }
+   if ((size_t)threadCount > count / DATEJOIN_MIN_SORT + 1) {
+      threadCount = (int)(count / DATEJOIN_MIN_SORT + 1);
+   }
+   if (threadCount < 1) {
+      threadCount = 1;
+   }
+   TraceSpan span("joinSort", "records", (long long)count);
+   vector<unsigned long long> scratch(count);
+   unsigned long long* source = &items[0];
+   unsigned long long* target = &scratch[0];
+   vector<size_t> counts((size_t)threadCount * 256);
+
+   for (int shift=32; shift<64; shift+=8) {
+      fill(counts.begin(), counts.end(), 0);
+      Workers::run(threadCount, [&](int t) {
+         size_t* digits = &counts[(size_t)t * 256];
+         size_t start = count * t / threadCount;
+         size_t end = count * (t + 1) / threadCount;
+         for (size_t i=start; i<end; i++) {
+            digits[(source[i] >> shift) & 0xff]++;
+         }
+      });
+
+      // places of the digits, in digit order and then thread order:
+      size_t place = 0;
+      int single = 0;
+      for (int digit=0; digit<256; digit++) {
+         size_t total = 0;
+         for (int t=0; t<threadCount; t++) {
+            size_t n = counts[(size_t)t * 256 + digit];
+            counts[(size_t)t * 256 + digit] = place;
+            place += n;
+            total += n;
+         }
+         if (total == count) {
+            single = 1;
+         }
+      }
+      if (single) {
+         continue;
+      }
+
+      Workers::run(threadCount, [&](int t) {
+         size_t* places = &counts[(size_t)t * 256];
+         size_t start = count * t / threadCount;
+         size_t end = count * (t + 1) / threadCount;
+         for (size_t i=start; i<end; i++) {
+            target[places[(source[i] >> shift) & 0xff]++] = source[i];
+         }
+      });
+      swap(source, target);
+   }
+   if (source != &items[0]) {
+      items.swap(scratch);
+   }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// DateJoin::findStream -- the index of the stream of a line, found by a
+//     binary search of the first lines of the streams.
+//
+
+int DateJoin::findStream(size_t line) const {
+   vector<Stream>::const_iterator it = upper_bound(streams.begin(),
+         streams.end(), line, [](size_t value, const Stream& stream) {
+      return value < stream.first;
+   });
+   if (it == streams.begin()) {
+      return 0;
+   }
+   return (int)(it - streams.begin()) - 1;
+}
+
+
+
+//////////////////////////////
+//
+// DateJoin::normalize -- read the date of every line and make the join
+//     items of the lines which have one (see sortByDay()), in line order.
+//     Worker threads take equal ranges of the lines, and convert the
+//     dates of each stream in blocks with Calendar::niceneDays().  Returns
+//     the number of lines (other than blank ones) without a date.
+//
+
+long long DateJoin::normalize(vector<unsigned long long>& items) {
+   size_t count = lines.size();
+   items.resize(count);
+   int workers = threadCount;
+   if ((size_t)workers > count / BULK_BLOCK_SIZE + 1) {
+      workers = (int)(count / BULK_BLOCK_SIZE + 1);
+   }
+   vector<long long> skipped(workers, 0);
+
+   Workers::run(workers, [&](int t) {
+      size_t start = count * t / workers;
+      size_t end = count * (t + 1) / workers;
+      TraceSpan span("joinNormalize", "line", (long long)start);
+      int years[BULK_BLOCK_SIZE];
+      int months[BULK_BLOCK_SIZE];
+      int days[BULK_BLOCK_SIZE];
+      int ndays[BULK_BLOCK_SIZE];
+      char valid[BULK_BLOCK_SIZE];
+      int index = findStream(start);
+      size_t i = start;
+      while (i < end) {
+         while (index + 1 < (int)streams.size() &&
+               streams[index + 1].first <= i) {
+            index++;
+         }
+         const Stream& stream = streams[index];
+         const char* streamEnd = stream.data + stream.size;
+         size_t blockEnd = i + BULK_BLOCK_SIZE;
+         if (blockEnd > end) {
+            blockEnd = end;
+         }
+         if (index + 1 < (int)streams.size() &&
+               blockEnd > streams[index + 1].first) {
+            blockEnd = streams[index + 1].first;
+         }
+
+         int n = (int)(blockEnd - i);
+         for (int k=0; k<n; k++) {
+            const char* p = lines[i + k];
+            const char* eol = (const char*)memchr(p, '\n', streamEnd - p);
+            if (eol == NULL) {
+               eol = streamEnd;
+            }
+            while (p < eol && (*p == ' ' || *p == '\t' || *p == '\r')) {
+               p++;
+            }
+            const char* field = (const char*)memchr(p, '\t', eol - p);
+            if (field == NULL) {
+               field = eol;
+            }
+            int year, month, day;
+            valid[k] = p < eol && DateParser::parse(p, field, year, month,
+                  day) && year <= CALENDAR_MAX_YEAR;
+            if (!valid[k]) {
+               skipped[t] += p < eol;
+               year  = 2000;
+               month = 1;
+               day   = 1;
+            }
+            years[k]  = year;
+            months[k] = month;
+            days[k]   = day;
+         }
+         Calendar::niceneDays(stream.locale, years, months, days, ndays, n);
+         for (int k=0; k<n; k++) {
+            if (valid[k]) {
+               items[i + k] = ((unsigned long long)((unsigned int)ndays[k] ^
+                     0x80000000u) << 32) | (i + k);
+            } else {
+               items[i + k] = DATEJOIN_NO_DATE;
+            }
+         }
+         i = blockEnd;
+      }
+   });
+
+   size_t kept = 0;
+   for (size_t i=0; i<count; i++) {
+      if (items[i] != DATEJOIN_NO_DATE) {
+         items[kept++] = items[i];
+      }
+   }
+   items.resize(kept);
+   long long total = 0;
+   for (int t=0; t<workers; t++) {
+      total += skipped[t];
+   }
+   return total;
+}
+
+
+
+//////////////////////////////
+//
+// DateJoin::writeRecords -- write the sorted items in the join mode.  The
+//     dates of the days are found together with Calendar::getDates(),
+//     which steps from one day to the next.
+//
+
+void DateJoin::writeRecords(const vector<unsigned long long>& items,
+      FILE* output) {
+   TraceSpan span("joinWrite", "records", (long long)items.size());
+   vector<int> ndays;
+   vector<size_t> groups;      // index of the first item of each day
+   for (size_t i=0; i<items.size(); i++) {
+      int nday = (int)((unsigned int)(items[i] >> 32) ^ 0x80000000u);
+      if (ndays.empty() || nday != ndays.back()) {
+         ndays.push_back(nday);
+         groups.push_back(i);
+      }
+   }
+   groups.push_back(items.size());
+   size_t dayCount = ndays.size();
+   vector<int> years(dayCount), months(dayCount), days(dayCount);
+   if (dayCount > 0) {
+      Calendar::getDates(toLocale, &ndays[0], &years[0], &months[0],
+            &days[0], (int)dayCount);
+   }
+
+   string buffer;
+   buffer.reserve(DATEJOIN_WRITE_SIZE + 4096);
+   if (mode == DATEJOIN_MODE_ALIGNED) {
+      buffer += "#date";
+      for (size_t s=0; s<streams.size(); s++) {
+         buffer += '\t';
+         buffer += streams[s].name;
+      }
+      buffer += '\n';
+   }
+
+   int streamCount = (int)streams.size();
+   vector<char> present(streamCount);
+   vector<string> columns(mode == DATEJOIN_MODE_ALIGNED ? streamCount : 0);
+   for (size_t g=0; g<dayCount; g++) {
+      size_t first = groups[g];
+      size_t last = groups[g + 1];
+      if (mode == DATEJOIN_MODE_INNER) {
+         fill(present.begin(), present.end(), 0);
+         int found = 0;
+         for (size_t i=first; i<last; i++) {
+            int s = findStream((size_t)(items[i] & 0xffffffffULL));
+            found += !present[s];
+            present[s] = 1;
+         }
+         if (found < streamCount) {
+            continue;
+         }
+      }
+
+      char date[32];
+      int dateLength = (int)(writeDate(date, years[g], months[g], days[g]) -
+            date);
+      for (size_t i=first; i<last; i++) {
+         size_t line = (size_t)(items[i] & 0xffffffffULL);
+         // the lines are read in day order, which is random in the files:
+         if (i + DATEJOIN_PREFETCH < items.size()) {
+            __builtin_prefetch(&lines[items[i + DATEJOIN_PREFETCH] &
+                  0xffffffffULL]);
+            __builtin_prefetch(lines[items[i + DATEJOIN_PREFETCH / 2] &
+                  0xffffffffULL]);
+         }
+         int s = findStream(line);
+         const char* p = lines[line];
+         const char* streamEnd = streams[s].data + streams[s].size;
+         const char* eol = (const char*)memchr(p, '\n', streamEnd - p);
+         if (eol == NULL) {
+            eol = streamEnd;
+         }
+         if (eol > p && eol[-1] == '\r') {
+            eol--;
+         }
+         if (mode == DATEJOIN_MODE_ALIGNED) {
+            string& column = columns[s];
+            if (!column.empty()) {
+               column += " | ";
+            }
+            size_t at = column.size();
+            column.append(p, eol - p);
+            replace(column.begin() + at, column.end(), '\t', ' ');
+         } else {
+            buffer.append(date, dateLength);
+            buffer += '\t';
+            buffer += streams[s].name;
+            buffer += '\t';
+            buffer.append(p, eol - p);
+            buffer += '\n';
+         }
+      }
+
+      if (mode == DATEJOIN_MODE_ALIGNED) {
+         buffer.append(date, dateLength);
+         for (int s=0; s<streamCount; s++) {
+            buffer += '\t';
+            buffer += columns[s];
+            columns[s].clear();
+         }
+         buffer += '\n';
+      }
+      if (buffer.size() >= DATEJOIN_WRITE_SIZE) {
+         fwrite(buffer.data(), 1, buffer.size(), output);
+         Stats::recordWrite(buffer.size());
+         buffer.clear();
+      }
+   }
+   fwrite(buffer.data(), 1, buffer.size(), output);
+   Stats::recordWrite(buffer.size());
+}
+
+
+
@@ -0,0 +1,86 @@
+//
+// Creation Date: Sun Oct 18 22:41:05 PDT 2026
+// Last Modified: Sun Oct 18 22:41:05 PDT 2026
+// Filename:      DateJoin.h
+// Syntax:        C++11
+//
+// Description:   Merge-join of files of dated records from different
+//                locales (--join).  Each file is a stream of lines whose
+//                first tab-separated field is a date in any DateParser
+//                form, written in the locale of the stream.  The dates of
+//                all streams are converted to Nicene days by worker
+//                threads with Calendar::niceneDays(), the records are put
+//                in day order with a parallel radix sort, and the records
+//                are written out by day in one of the DATEJOIN_MODE forms.
+//                Records of the same day keep the order of the streams
+//                and of their lines.
+//
+// Output lines are tab-separated, starting with the date of the day in
+// the output locale as YYYY-MM-DD:
+//    merge    date, stream name, record line (every record)
+//    inner    as merge, but only days which have records in every stream
+//    aligned  date, then one column per stream holding the lines of the
+//             stream on that day separated by " | " (a "#date" header
+//             line names the streams)
+//
+
+#ifndef _DATEJOIN_H_INCLUDED
+#define _DATEJOIN_H_INCLUDED
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Output forms:
+#define DATEJOIN_MODE_UNKNOWN  -1
+#define DATEJOIN_MODE_MERGE     0
+#define DATEJOIN_MODE_INNER     1
+#define DATEJOIN_MODE_ALIGNED   2
+
+
+class DateJoin {
+   public:
+                         DateJoin        (void);
+                        ~DateJoin        ();
+
+      int                addFile         (const string& filename,
+                                            int aLocale);
+      int                join            (FILE* output = stdout);
+      void               setMode         (int aMode);
+      void               setThreadCount  (int count);
+      void               setToLocale     (int aLocale);
+
+      static int         getModeByName   (const char* name);
+      static void        sortByDay       (vector<unsigned long long>& items,
+                                            int threadCount);
+
+   private:
+      struct Stream {
+         string          name;           // file name as given
+         int             locale;         // locale of the dates
+         const char*     data;           // mapped contents
+         size_t          size;           // size of the contents
+         void*           mapping;        // mapping, or NULL if empty
+         size_t          first;          // index of the first line
+      };
+
+      vector<Stream>     streams;        // input files in the order added
+      vector<const char*> lines;         // start of every line of every
+                                         // stream, in stream order
+      int                mode;           // DATEJOIN_MODE_MERGE, etc.
+      int                toLocale;       // locale of the output dates
+      int                threadCount;    // number of worker threads
+
+      int                findStream      (size_t line) const;
+      long long          normalize       (vector<unsigned long long>& items);
+      void               writeRecords    (const vector<unsigned long long>&
+                                            items, FILE* output);
+};
+
+
+#endif  // _DATEJOIN_H_INCLUDED
+
+
+
@@ -0,0 +1,479 @@
+//
+// Creation Date: Sun Oct 18 16:10:53 PDT 2026
+// Last Modified: Sun Oct 18 16:10:53 PDT 2026
+// Filename:      DateParser.cpp
+// Syntax:        C++11
+//
+// Description:   Allocation-free parsing of date strings.  Month names are
+//                looked up in a byte trie which is built once from the
+//                table below when the program starts.  Each trie node
+//                records the month shared by all of the names passing
+//                through it (or that the prefix is ambiguous), so an
+//                abbreviation is resolved by the same walk as a full name.
+//
+
+#include "DateParser.h"
+#include <cstring>
+
+// Maximum number of nodes in the month name trie:
+#define TRIE_SIZE          4096
+
+// Minimum number of letters in an abbreviated month name:
+#define MIN_PREFIX         3
+
+// Maximum number of digits in a number:
+#define MAX_DIGITS         9
+
+// Character classes:
+#define CHAR_OTHER         0
+#define CHAR_SEPARATOR     1
+#define CHAR_DIGIT         2
+#define CHAR_LETTER        3
+
+// Token types:
+#define TOKEN_NUMBER       0
+#define TOKEN_YEAR         1
+#define TOKEN_MONTH        2
+
+// Month names, lowercase UTF-8 (uppercase is folded before lookup):
+static const char* monthNames[12][40] = {
+   { "january", "ianuarius", "januarius", "ianuarii", "januarii", "janvier",
+     "gennaio", "enero", "janeiro", "januar", "jänner", "janner", "januari",
+     "január", "ianuarie", "ocak", "январь", "января", "ιανουάριος",
+     "ιανουαρίου", "ιανουαριος", "ιανουαριου", NULL },
+   { "february", "februarius", "februarii", "février", "fevrier",
+     "febbraio", "febrero", "fevereiro", "februar", "feber", "februari",
+     "február", "februarie", "şubat", "subat", "февраль", "февраля",
+     "φεβρουάριος", "φεβρουαρίου", "φεβρουαριος", "φεβρουαριου", NULL },
+   { "march", "martius", "martii", "mars", "marzo", "março", "marco",
+     "märz", "marz", "maerz", "maart", "marts", "március", "marcius",
+     "martie", "mart", "март", "марта", "μάρτιος", "μαρτίου", "μαρτιος",
+     "μαρτιου", NULL },
+   { "april", "aprilis", "avril", "aprile", "abril", "április", "aprilie",
+     "nisan", "апрель", "апреля", "απρίλιος", "απριλίου", "απριλιος",
+     "απριλιου", NULL },
+   { "may", "maius", "maii", "mai", "maggio", "mayo", "maio", "mei", "maj",
+     "május", "majus", "mayıs", "mayis", "май", "мая", "μάιος", "μαΐου",
+     "μαιος", "μαιου", NULL },
+   { "june", "iunius", "junius", "iunii", "junii", "juin", "giugno", "junio",
+     "junho", "juni", "június", "iunie", "haziran", "июнь", "июня",
+     "ιούνιος", "ιουνίου", "ιουνιος", "ιουνιου", NULL },
+   { "july", "iulius", "julius", "iulii", "julii", "juillet", "luglio",
+     "julio", "julho", "juli", "július", "iulie", "temmuz", "июль", "июля",
+     "ιούλιος", "ιουλίου", "ιουλιος", "ιουλιου", NULL },
+   { "august", "augustus", "augusti", "août", "aout", "agosto",
+     "augusztus", "ağustos", "agustos", "август", "августа", "αύγουστος",
+     "αυγούστου", "αυγουστος", "αυγουστου", NULL },
+   { "september", "septembris", "septembre", "settembre", "septiembre",
+     "setiembre", "setembro", "szeptember", "septembrie", "eylül", "eylul",
+     "сентябрь", "сентября", "σεπτέμβριος", "σεπτεμβρίου", "σεπτεμβριος",
+     "σεπτεμβριου", NULL },
+   { "october", "octobris", "octobre", "ottobre", "octubre", "outubro",
+     "oktober", "október", "octombrie", "ekim", "октябрь", "октября",
+     "οκτώβριος", "οκτωβρίου", "οκτωβριος", "οκτωβριου", NULL },
+   { "november", "novembris", "novembre", "noviembre", "novembro",
+     "noiembrie", "kasım", "kasim", "ноябрь", "ноября", "νοέμβριος",
+     "νοεμβρίου", "νοεμβριος", "νοεμβριου", NULL },
+   { "december", "decembris", "décembre", "decembre", "dicembre",
+     "diciembre", "dezembro", "dezember", "desember", "decembrie", "aralık",
+     "aralik", "декабрь", "декабря", "δεκέμβριος", "δεκεμβρίου",
+     "δεκεμβριος", "δεκεμβριου", NULL }
+};
+
+class TrieNode {
+   public:
+      short              child;          // first child, or 0 for none
+      short              sibling;        // next sibling, or 0 for none
+      unsigned char      ch;             // byte leading to this node
+      signed char        month;          // month of all names through node,
+                                         //    or -1 if ambiguous
+      signed char        exact;          // month if a name ends here
+};
+
+class ParserTables {
+   public:
+                         ParserTables    (void);
+      void               insert          (const char* name, int month);
+
+      unsigned char      charClass[256];
+      short              root[256];      // trie node for each first byte
+      TrieNode           node[TRIE_SIZE];
+      int                nodeCount;
+};
+
+static ParserTables tables;
+
+static int         foldCase        (const unsigned char* p,
+                                      const unsigned char* end,
+                                      unsigned char* folded);
+static const char* parseDualYear   (const char* p, const char* end,
+                                      int& year, int digits);
+static const char* parseNumber     (const char* p, const char* end,
+                                      int& value, int& digits);
+
+
+//////////////////////////////
+//
+// DateParser::parse -- parse a date string.  Returns 1 and sets the
+//     year, month and day if the string is a complete date, otherwise
+//     returns 0 and leaves them unchanged.  The day is checked only to be
+//     in the range 1 to 31.
+//
+
+int DateParser::parse(const char* text, int& year, int& month, int& day) {
+   return parse(text, text + strlen(text), year, month, day);
+}
+
+
+int DateParser::parse(const char* start, const char* end, int& year,
+      int& month, int& day) {
+   int value[3];
+   int digits[3];
+   int type[3];
+   int count = 0;
+   const char* p = start;
+   while (p < end) {
+      const unsigned char* u = (const unsigned char*)p;
+      switch (tables.charClass[*u]) {
+         case CHAR_SEPARATOR:
+            p++;
+            continue;
+         case CHAR_DIGIT:
+            if (count == 3) {
+               return 0;
+            }
+            p = parseNumber(p, end, value[count], digits[count]);
+            if (p == NULL) {
+               return 0;
+            }
+            type[count] = TOKEN_NUMBER;
+            if (p < end && *p == '/' && digits[count] >= 3) {
+               p = parseDualYear(p, end, value[count], digits[count]);
+               if (p == NULL) {
+                  return 0;
+               }
+               type[count] = TOKEN_YEAR;
+            } else if (end - p >= 2 && tables.charClass[*(const unsigned
+                  char*)p] == CHAR_LETTER) {
+               // ordinal suffix such as 14th:
+               char a = p[0] | 0x20;
+               char b = p[1] | 0x20;
+               if ((a == 's' && b == 't') || (a == 'n' && b == 'd') ||
+                     (a == 'r' && b == 'd') || (a == 't' && b == 'h')) {
+                  p += 2;
+               }
+            }
+            count++;
+            break;
+         case CHAR_LETTER: {
+            if (count == 3) {
+               return 0;
+            }
+            const char* word = p;
+            while (p < end && tables.charClass[(unsigned char)*p] ==
+                  CHAR_LETTER) {
+               p++;
+            }
+            value[count] = lookupMonth(word, (int)(p - word));
+            if (value[count] == 0) {
+               return 0;
+            }
+            type[count] = TOKEN_MONTH;
+            digits[count] = 0;
+            count++;
+            break;
+         }
+         default:
+            return 0;
+      }
+      if (p < end && tables.charClass[(unsigned char)*p] != CHAR_SEPARATOR) {
+         return 0;
+      }
+   }
+   if (count != 3) {
+      return 0;
+   }
+
+   int y, m, d;
+   int yearFirst = type[0] == TOKEN_YEAR ||
+         (type[0] == TOKEN_NUMBER && digits[0] >= 3);
+   if (type[0] == TOKEN_MONTH) {
+      // September 14, 1752
+      m = value[0];  d = value[1];  y = value[2];
+      if (type[1] != TOKEN_NUMBER || type[2] == TOKEN_MONTH) {
+         return 0;
+      }
+   } else if (yearFirst) {
+      // 1752-09-14 or 1752 Sep 14
+      y = value[0];  m = value[1];  d = value[2];
+      if (type[2] != TOKEN_NUMBER || type[1] == TOKEN_YEAR) {
+         return 0;
+      }
+   } else {
+      // 14 9 1752 or 14 Sep 1752
+      d = value[0];  m = value[1];  y = value[2];
+      if (type[1] == TOKEN_YEAR || type[2] == TOKEN_MONTH) {
+         return 0;
+      }
+   }
+   if (m < 1 || m > 12 || d < 1 || d > 31 || y < 1) {
+      return 0;
+   }
+   year  = y;
+   month = m;
+   day   = d;
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// DateParser::parseYear -- parse a year, either a number or an Old
+//     Style/New Style year such as 1750/51 (giving 1751).  Returns 1 and
+//     sets year on success, otherwise returns 0.
+//
+
+int DateParser::parseYear(const char* text, int& year) {
+   const char* end = text + strlen(text);
+   int value, digits;
+   const char* p = parseNumber(text, end, value, digits);
+   if (p == NULL || digits == 0) {
+      return 0;
+   }
+   if (p < end && *p == '/') {
+      p = parseDualYear(p, end, value, digits);
+      if (p == NULL) {
+         return 0;
+      }
+   }
+   if (p != end || value < 1) {
+      return 0;
+   }
+   year = value;
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// DateParser::lookupMonth -- returns the month (1-12) for a month name
+//     or an unambiguous abbreviation of at least three letters, or 0
+//     if the word is not recognized.  Letters may be in either case.
+//
+
+int DateParser::lookupMonth(const char* word) {
+   return lookupMonth(word, (int)strlen(word));
+}
+
+
+int DateParser::lookupMonth(const char* word, int length) {
+   const unsigned char* p = (const unsigned char*)word;
+   const unsigned char* end = p + length;
+   unsigned char folded[2];
+   int letters = 0;
+   int current = 0;
+   while (p < end) {
+      int size = foldCase(p, end, folded);
+      for (int i=0; i<size; i++) {
+         if (current == 0) {
+            current = tables.root[folded[i]];
+         } else {
+            current = tables.node[current].child;
+            while (current != 0 && tables.node[current].ch != folded[i]) {
+               current = tables.node[current].sibling;
+            }
+         }
+         if (current == 0) {
+            return 0;
+         }
+      }
+      p += size;
+      letters++;
+   }
+   if (current == 0) {
+      return 0;
+   }
+   if (tables.node[current].exact > 0) {
+      return tables.node[current].exact;
+   }
+   if (letters >= MIN_PREFIX && tables.node[current].month > 0) {
+      return tables.node[current].month;
+   }
+   return 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// ParserTables::ParserTables -- fill in the character classes and build
+//     the month name trie.  Node 0 is unused so that 0 can mean "none".
+//
+
+ParserTables::ParserTables(void) {
+   int i;
+   for (i=0; i<256; i++) {
+      charClass[i] = CHAR_OTHER;
+      root[i] = 0;
+   }
+   const char* separators = " \t\r,.-/";
+   for (i=0; separators[i] != '\0'; i++) {
+      charClass[(unsigned char)separators[i]] = CHAR_SEPARATOR;
+   }
+   for (i='0'; i<='9'; i++) {
+      charClass[i] = CHAR_DIGIT;
+   }
+   for (i='a'; i<='z'; i++) {
+      charClass[i] = CHAR_LETTER;
+      charClass[i - 'a' + 'A'] = CHAR_LETTER;
+   }
+   for (i=0x80; i<256; i++) {
+      charClass[i] = CHAR_LETTER;
+   }
+
+   memset(node, 0, sizeof(node));
+   nodeCount = 1;
+   for (int m=0; m<12; m++) {
+      for (i=0; monthNames[m][i] != NULL; i++) {
+         insert(monthNames[m][i], m + 1);
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// ParserTables::insert -- add a lowercase month name to the trie.
+//
+
+void ParserTables::insert(const char* name, int month) {
+   const unsigned char* p = (const unsigned char*)name;
+   int current = 0;
+   for ( ; *p != '\0'; p++) {
+      short* link = current == 0 ? &root[*p] : &node[current].child;
+      while (*link != 0 && node[*link].ch != *p) {
+         link = &node[*link].sibling;
+      }
+      if (*link == 0) {
+         if (nodeCount >= TRIE_SIZE) {
+            return;
+         }
+         *link = (short)nodeCount;
+         node[nodeCount].ch = *p;
+         nodeCount++;
+      }
+      current = *link;
+      if (node[current].month == 0) {
+         node[current].month = (signed char)month;
+      } else if (node[current].month != month) {
+         node[current].month = -1;
+      }
+   }
+   node[current].exact = (signed char)month;
+}
+
+
+
+//////////////////////////////
+//
+// foldCase -- write the lowercase form of the character starting at p
+//     into folded and return the number of bytes in the character (1 or 2).
+//     ASCII, Latin-1, Cyrillic and unaccented Greek capitals are folded.
+//
+
+static int foldCase(const unsigned char* p, const unsigned char* end,
+      unsigned char* folded) {
+   unsigned char a = p[0];
+   if (a < 0x80) {
+      folded[0] = (a >= 'A' && a <= 'Z') ? a + 0x20 : a;
+      return 1;
+   }
+   if (a < 0xC0 || p + 1 >= end) {
+      folded[0] = a;
+      return 1;
+   }
+   unsigned char b = p[1];
+   folded[0] = a;
+   folded[1] = b;
+   if (a == 0xC3 && b >= 0x80 && b <= 0x9E && b != 0x97) {
+      folded[1] = b + 0x20;                     // À-Þ
+   } else if (a == 0xD0 && b >= 0x90 && b <= 0x9F) {
+      folded[1] = b + 0x20;                     // А-П
+   } else if (a == 0xD0 && b >= 0xA0 && b <= 0xAF) {
+      folded[0] = 0xD1;                         // Р-Я
+      folded[1] = b - 0x20;
+   } else if (a == 0xCE && b >= 0x91 && b <= 0x9F) {
+      folded[1] = b + 0x20;                     // Α-Ο
+   } else if (a == 0xCE && b >= 0xA0 && b <= 0xA9) {
+      folded[0] = 0xCF;                         // Π-Ω
+      folded[1] = b - 0x20;
+   }
+   return 2;
+}
+
+
+
+//////////////////////////////
+//
+// parseDualYear -- read the New Style part of a year such as 1750/51 or
+//     1750/1751, where p points at the slash and year holds the Old Style
+//     year with the given number of digits.  The New Style year replaces
+//     year.  Returns a pointer after the year, or NULL if the second
+//     part is missing or is not the following year.
+//
+
+static const char* parseDualYear(const char* p, const char* end, int& year,
+      int digits) {
+   int later, laterDigits;
+   p = parseNumber(p + 1, end, later, laterDigits);
+   if (p == NULL || laterDigits == 0 || laterDigits > digits) {
+      return NULL;
+   }
+   int modulus = 1;
+   for (int i=0; i<laterDigits; i++) {
+      modulus *= 10;
+   }
+   later += year - year % modulus;
+   if (later <= year) {
+      later += modulus;
+   }
+   if (later != year + 1) {
+      return NULL;
+   }
+   year = later;
+   return p;
+}
+
+
+
+//////////////////////////////
+//
+// parseNumber -- read the digits at p.  Returns a pointer after the
+//     number, or NULL if it has more than MAX_DIGITS digits.
+//
+
+static const char* parseNumber(const char* p, const char* end, int& value,
+      int& digits) {
+   const char* start = p;
+   int number = 0;
+   while (p < end && (unsigned)(*p - '0') <= 9) {
+      if (p - start == MAX_DIGITS) {
+         return NULL;
+      }
+      number = number * 10 + (*p - '0');
+      p++;
+   }
+   digits = (int)(p - start);
+   value = number;
+   return p;
+}
+
+
+
@@ -0,0 +1,42 @@
+//
+// Creation Date: Sun Oct 18 16:10:53 PDT 2026
+// Last Modified: Sun Oct 18 16:10:53 PDT 2026
+// Filename:      DateParser.h
+// Syntax:        C++11
+//
+// Description:   Allocation-free parsing of date strings.  Accepted forms:
+//                   14 9 1752            (day month year, as on the
+//                                         hcal command line)
+//                   1752-09-14           (ISO year-month-day)
+//                   14 Sep 1752, 14 September 1752
+//                   September 14, 1752, Sep 14 1752
+//                   1752 Sep 14
+//                Years may be written in Old Style/New Style form, such
+//                as 1750/51 or 1750/1751, which gives the later year.
+//                Month names are recognized in English, Latin, French,
+//                Italian, Spanish, Portuguese, German, Dutch, Danish/
+//                Norwegian, Hungarian, Romanian, Turkish, Russian and
+//                Greek, along with any unambiguous prefix of at least
+//                three letters.
+//
+
+#ifndef _DATEPARSER_H_INCLUDED
+#define _DATEPARSER_H_INCLUDED
+
+
+class DateParser {
+   public:
+      static int         parse           (const char* text, int& year,
+                                            int& month, int& day);
+      static int         parse           (const char* start, const char* end,
+                                            int& year, int& month, int& day);
+      static int         parseYear       (const char* text, int& year);
+      static int         lookupMonth     (const char* word, int length);
+      static int         lookupMonth     (const char* word);
+};
+
+
+#endif  // _DATEPARSER_H_INCLUDED
+
+
+
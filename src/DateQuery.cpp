@@ -0,0 +1,860 @@
+//
+// Creation Date: Sun Oct 18 23:38:15 PDT 2026
+// Last Modified: Sun Oct 18 23:38:15 PDT 2026
+// Filename:      DateQuery.cpp
+// Syntax:        C++11
+//
+// Description:   Search of a range of days for the days matching a
+//                predicate.  See DateQuery.h.
+//
+
+#include "Calendar.h"
+#include "DateParser.h"
+#include "DateQuery.h"
+#include "DayCursor.h"
+#include "NumberFormat.h"
+#include "Stats.h"
+#include "Trace.h"
+#include "Workers.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+using namespace std;
+
+// Node types:
+#define QUERY_NODE_COMPARE       0
+#define QUERY_NODE_AND           1
+#define QUERY_NODE_OR            2
+#define QUERY_NODE_NOT           3
+
+// Comparisons:
+#define QUERY_OP_EQUAL           0
+#define QUERY_OP_NOT_EQUAL       1
+#define QUERY_OP_LESS            2
+#define QUERY_OP_LESS_EQUAL      3
+#define QUERY_OP_GREATER         4
+#define QUERY_OP_GREATER_EQUAL   5
+
+// Fields:
+#define QUERY_FIELD_WEEKDAY      0
+#define QUERY_FIELD_DAY          1
+#define QUERY_FIELD_MONTH        2
+#define QUERY_FIELD_YEAR         3
+#define QUERY_FIELD_CALENDAR     4
+
+static const char* fieldNames[] = {
+   "weekday", "day", "month", "year", "calendar", NULL
+};
+
+static const char* weekdayNames[] = {
+   "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday",
+   "Saturday", NULL
+};
+
+
+//////////////////////////////
+//
+// DateQuery::DateQuery --
+//
+
+DateQuery::DateQuery(void) {
+   root        = -1;
+   jumpLocale  = LOCALE_UNKNOWN;
+   jumpMonth   = 0;
+   jumpDay     = 0;
+   locale      = LOCALE_ENGLAND;
+   outputType  = QUERY_OUTPUT_DAYS;
+   threadCount = Workers::getDefaultThreadCount();
+   position    = 0;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::~DateQuery --
+//
+
+DateQuery::~DateQuery() { }
+
+
+
+//////////////////////////////
+//
+// DateQuery::find -- write the days from startDay to endDay inclusive
+//     which match the predicate.  Returns the exit status for the program.
+//     At most two chunks per thread are held in memory at once.
+//     default value: output = stdout
+//
+
+int DateQuery::find(int startDay, int endDay, FILE* output) {
+   vector<int> spans;
+   getSpans(startDay, endDay, spans);
+
+   // split long spans, and group the spans into chunks of at most
+   // QUERY_CHUNK_DAYS days:
+   vector<int> pieces;
+   for (size_t i=0; i<spans.size(); i+=2) {
+      for (int k=0; k<spans[i+1]; k+=QUERY_CHUNK_DAYS) {
+         int count = spans[i+1] - k;
+         pieces.push_back(spans[i] + k);
+         pieces.push_back(count < QUERY_CHUNK_DAYS ? count :
+               QUERY_CHUNK_DAYS);
+      }
+   }
+   vector<size_t> bounds(1, 0);
+   int days = 0;
+   for (size_t i=0; i<pieces.size(); i+=2) {
+      if (days + pieces[i+1] > QUERY_CHUNK_DAYS) {
+         bounds.push_back(i);
+         days = 0;
+      }
+      days += pieces[i+1];
+   }
+   if (days > 0) {
+      bounds.push_back(pieces.size());
+   }
+
+   size_t chunkCount = bounds.size() - 1;
+   vector<vector<int> > matches(chunkCount);
+   long long total = 0;
+   int lastYear = 0;
+   int haveYear = 0;
+   string text;
+
+   Workers::runOrdered(threadCount, chunkCount, (size_t)threadCount * 2,
+         "find", [&](size_t k) {
+      TraceSpan span("findChunk", "chunk", (int)k);
+      scan(&pieces[bounds[k]], (int)((bounds[k+1] - bounds[k]) / 2),
+            matches[k]);
+   }, [&](size_t k) {
+      // write the matches of the chunks in order as they are finished:
+      TraceSpan span("output", "chunk", (int)k);
+      Stats::startPhase(STATS_PHASE_OUTPUT);
+      text.clear();
+      const vector<int>& found = matches[k];
+      total += found.size();
+      for (size_t i=0; i<found.size(); i++) {
+         if (outputType == QUERY_OUTPUT_COUNT) {
+            break;
+         }
+         int year, month, day;
+         Calendar::getDate(locale, found[i], year, month, day);
+         char line[64];
+         char* p = line;
+         if (outputType == QUERY_OUTPUT_DAYS) {
+            int weekday = ((found[i] % 7 - 1) + 14) % 7;
+            int calendar = Calendar::getCalendar(locale, found[i]);
+            const char* weekdayName = weekdayNames[weekday];
+            const char* calendarName = Calendar::getCalendarName(calendar);
+            p = writeDate(p, year, month, day);
+            *p++ = '\t';
+            memcpy(p, weekdayName, strlen(weekdayName));
+            p += strlen(weekdayName);
+            *p++ = '\t';
+            memcpy(p, calendarName, strlen(calendarName));
+            p += strlen(calendarName);
+            *p++ = '\n';
+         } else if (!haveYear || year != lastYear) {
+            p = writeInt(p, year);
+            *p++ = '\n';
+            lastYear = year;
+            haveYear = 1;
+         }
+         text.append(line, p - line);
+      }
+      fwrite(text.data(), 1, text.size(), output);
+      Stats::recordWrite(text.size());
+      Stats::stopPhase(STATS_PHASE_OUTPUT);
+      vector<int>().swap(matches[k]);
+   });
+
+   if (outputType == QUERY_OUTPUT_COUNT) {
+      fprintf(output, "%lld\n", total);
+   }
+   fflush(output);
+   return ferror(output) ? 1 : 0;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::findDays -- add the matching days among the count days from
+//     startDay to matches, in order, in the calling thread.
+//
+
+void DateQuery::findDays(int startDay, int count, vector<int>& matches)
+      const {
+   vector<int> spans;
+   getSpans(startDay, startDay + count - 1, spans);
+   if (!spans.empty()) {
+      scan(&spans[0], (int)spans.size() / 2, matches);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::getError -- the message of the last parse() failure.
+//
+
+const string& DateQuery::getError(void) const {
+   return error;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::getOutputByName -- QUERY_OUTPUT_DAYS for "days", etc., or
+//     QUERY_OUTPUT_UNKNOWN.
+//
+
+int DateQuery::getOutputByName(const char* name) {
+   if (strcmp(name, "days") == 0) {
+      return QUERY_OUTPUT_DAYS;
+   } else if (strcmp(name, "years") == 0) {
+      return QUERY_OUTPUT_YEARS;
+   } else if (strcmp(name, "count") == 0) {
+      return QUERY_OUTPUT_COUNT;
+   }
+   return QUERY_OUTPUT_UNKNOWN;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::parse -- read a predicate.  Returns 0 if it cannot be read,
+//     with the reason given by getError().
+//
+
+int DateQuery::parse(const string& expression) {
+   nodes.clear();
+   columns.clear();
+   root = -1;
+   error.clear();
+   if (!tokenize(expression)) {
+      return 0;
+   }
+   position = 0;
+   int top = parseOr();
+   if (top >= 0 && position < tokens.size()) {
+      error = "unexpected \"" + tokens[position] + "\"";
+      top = -1;
+   }
+   if (top < 0) {
+      nodes.clear();
+      columns.clear();
+      return 0;
+   }
+   root = top;
+   jumpLocale = LOCALE_UNKNOWN;
+   jumpMonth  = 0;
+   jumpDay    = 0;
+   findJumps(root);
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::setLocale -- the locale of unqualified fields and of the
+//     dates written out.
+//
+
+void DateQuery::setLocale(int aLocale) {
+   locale = aLocale;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::setOutput -- QUERY_OUTPUT_DAYS, _YEARS or _COUNT.
+//
+
+void DateQuery::setOutput(int anOutput) {
+   outputType = anOutput;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::setThreadCount -- set the number of worker threads, or the
+//     number of hardware threads if count is less than 1.
+//
+
+void DateQuery::setThreadCount(int count) {
+   if (count < 1) {
+      count = Workers::getDefaultThreadCount();
+   }
+   threadCount = count;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// DateQuery::addColumn -- the index of the column of a field, adding it
+//     if it is not used yet.  Unqualified fields have the locale
+//     LOCALE_UNKNOWN, which stands for the locale of the query.  Weekdays
+//     are the same in every locale.
+//
+
+int DateQuery::addColumn(int aLocale, int field) {
+   if (field == QUERY_FIELD_WEEKDAY) {
+      aLocale = LOCALE_GREGORIAN;
+   }
+   for (size_t i=0; i<columns.size(); i++) {
+      if (columns[i].locale == aLocale && columns[i].field == field) {
+         return (int)i;
+      }
+   }
+   Column column;
+   column.locale = aLocale;
+   column.field  = field;
+   columns.push_back(column);
+   return (int)columns.size() - 1;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::evaluate -- set mask[i] to 1 for the days of a block for
+//     which a node is true and to 0 for the others.  The values of the
+//     columns of the block are given in values.  The right side of an
+//     and is skipped when no day of the block passes the left side.
+//
+
+void DateQuery::evaluate(int index, const vector<int>* values, int count,
+      unsigned char* mask) const {
+   const Node& node = nodes[index];
+   if (node.type == QUERY_NODE_NOT) {
+      evaluate(node.left, values, count, mask);
+      for (int i=0; i<count; i++) {
+         mask[i] ^= 1;
+      }
+      return;
+   } else if (node.type == QUERY_NODE_AND || node.type == QUERY_NODE_OR) {
+      evaluate(node.left, values, count, mask);
+      if (node.type == QUERY_NODE_AND) {
+         unsigned char any = 0;
+         for (int i=0; i<count; i++) {
+            any |= mask[i];
+         }
+         if (!any) {
+            return;
+         }
+      }
+      unsigned char other[QUERY_BLOCK_DAYS];
+      evaluate(node.right, values, count, other);
+      if (node.type == QUERY_NODE_AND) {
+         for (int i=0; i<count; i++) {
+            mask[i] &= other[i];
+         }
+      } else {
+         for (int i=0; i<count; i++) {
+            mask[i] |= other[i];
+         }
+      }
+      return;
+   }
+
+   const int* v = &values[node.column][0];
+   int x = node.value;
+   switch (node.op) {
+      case QUERY_OP_EQUAL:
+         for (int i=0; i<count; i++) {
+            mask[i] = v[i] == x;
+         }
+         break;
+      case QUERY_OP_NOT_EQUAL:
+         for (int i=0; i<count; i++) {
+            mask[i] = v[i] != x;
+         }
+         break;
+      case QUERY_OP_LESS:
+         for (int i=0; i<count; i++) {
+            mask[i] = v[i] < x;
+         }
+         break;
+      case QUERY_OP_LESS_EQUAL:
+         for (int i=0; i<count; i++) {
+            mask[i] = v[i] <= x;
+         }
+         break;
+      case QUERY_OP_GREATER:
+         for (int i=0; i<count; i++) {
+            mask[i] = v[i] > x;
+         }
+         break;
+      case QUERY_OP_GREATER_EQUAL:
+         for (int i=0; i<count; i++) {
+            mask[i] = v[i] >= x;
+         }
+         break;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::findJumps -- look through the and-ed comparisons at the top
+//     of the predicate for a required day and/or month of one locale.
+//
+
+void DateQuery::findJumps(int index) {
+   const Node& node = nodes[index];
+   if (node.type == QUERY_NODE_AND) {
+      findJumps(node.left);
+      findJumps(node.right);
+      return;
+   }
+   if (node.type != QUERY_NODE_COMPARE || node.op != QUERY_OP_EQUAL) {
+      return;
+   }
+   const Column& column = columns[node.column];
+   if (column.field != QUERY_FIELD_DAY && column.field != QUERY_FIELD_MONTH) {
+      return;
+   }
+   if (jumpMonth == 0 && jumpDay == 0) {
+      jumpLocale = column.locale;
+   } else if (column.locale != jumpLocale) {
+      return;
+   }
+   if (column.field == QUERY_FIELD_MONTH && jumpMonth == 0) {
+      jumpMonth = node.value;
+   } else if (column.field == QUERY_FIELD_DAY && jumpDay == 0) {
+      jumpDay = node.value;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::getSpans -- the ranges of days from startDay to endDay
+//     inclusive which need to be evaluated, as pairs of first day and
+//     number of days in increasing order.  With a required month and day
+//     this is one day a year, with a required day twelve days a year, and
+//     with a required month one month a year.  Dates dropped by a reform
+//     or past the end of a month are not evaluated.
+//
+
+void DateQuery::getSpans(int startDay, int endDay, vector<int>& spans)
+      const {
+   spans.clear();
+   if (endDay < startDay) {
+      return;
+   }
+   if (jumpMonth == 0 && jumpDay == 0) {
+      spans.push_back(startDay);
+      spans.push_back(endDay - startDay + 1);
+      return;
+   }
+   if (jumpMonth < 0 || jumpMonth > 12 || jumpDay < 0 || jumpDay > 31) {
+      return;
+   }
+
+   int aLocale = jumpLocale == LOCALE_UNKNOWN ? locale : jumpLocale;
+   int firstYear = Calendar::getYear(aLocale, startDay);
+   int lastYear = Calendar::getYear(aLocale, endDay);
+   for (int year=firstYear; year<=lastYear; year++) {
+      for (int month=1; month<=12; month++) {
+         if (jumpMonth != 0 && month != jumpMonth) {
+            continue;
+         }
+         int first, last;
+         if (jumpDay != 0) {
+            int calendar = Calendar::getCalendar(aLocale, year, month,
+                  jumpDay);
+            first = Calendar::niceneDay(calendar, year, month, jumpDay);
+            int y, m, d;
+            Calendar::getDate(aLocale, first, y, m, d);
+            if (y != year || m != month || d != jumpDay) {
+               continue;
+            }
+            last = first;
+         } else {
+            first = Calendar::firstDayFrom(aLocale, year, month, 1);
+            last = Calendar::firstDayFrom(aLocale, month == 12 ? year + 1 :
+                  year, month % 12 + 1, 1) - 1;
+         }
+         if (first < startDay) {
+            first = startDay;
+         }
+         if (last > endDay) {
+            last = endDay;
+         }
+         if (first <= last) {
+            spans.push_back(first);
+            spans.push_back(last - first + 1);
+         }
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::parseAnd -- read terms joined by "and".  Returns the node,
+//     or -1 on an error.
+//
+
+int DateQuery::parseAnd(void) {
+   int left = parseNot();
+   while (left >= 0 && position < tokens.size() &&
+         (strcasecmp(tokens[position].c_str(), "and") == 0 ||
+          tokens[position] == "&&")) {
+      position++;
+      int right = parseNot();
+      if (right < 0) {
+         return -1;
+      }
+      Node node;
+      node.type   = QUERY_NODE_AND;
+      node.left   = left;
+      node.right  = right;
+      node.column = -1;
+      node.op     = -1;
+      node.value  = 0;
+      nodes.push_back(node);
+      left = (int)nodes.size() - 1;
+   }
+   return left;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::parseCompare -- read "field op value", where the field may
+//     be qualified by a locale as in "julian.month".  Returns the node, or
+//     -1 on an error.
+//
+
+int DateQuery::parseCompare(void) {
+   if (position + 3 > tokens.size()) {
+      error = "incomplete comparison at the end of the predicate";
+      return -1;
+   }
+   string name = tokens[position];
+   int aLocale = LOCALE_UNKNOWN;
+   size_t dot = name.find('.');
+   if (dot != string::npos) {
+      aLocale = Calendar::getLocaleByName(name.substr(0, dot).c_str());
+      if (aLocale == LOCALE_UNKNOWN) {
+         error = "unknown locale \"" + name.substr(0, dot) + "\"";
+         return -1;
+      }
+      name = name.substr(dot + 1);
+   }
+   int field = -1;
+   for (int i=0; fieldNames[i] != NULL; i++) {
+      if (strcasecmp(name.c_str(), fieldNames[i]) == 0) {
+         field = i;
+      }
+   }
+   if (field < 0) {
+      error = "unknown field \"" + tokens[position] + "\"";
+      return -1;
+   }
+
+   const string& symbol = tokens[position + 1];
+   int op;
+   if (symbol == "=" || symbol == "==") {
+      op = QUERY_OP_EQUAL;
+   } else if (symbol == "!=") {
+      op = QUERY_OP_NOT_EQUAL;
+   } else if (symbol == "<") {
+      op = QUERY_OP_LESS;
+   } else if (symbol == "<=") {
+      op = QUERY_OP_LESS_EQUAL;
+   } else if (symbol == ">") {
+      op = QUERY_OP_GREATER;
+   } else if (symbol == ">=") {
+      op = QUERY_OP_GREATER_EQUAL;
+   } else {
+      error = "expected a comparison after \"" + tokens[position] +
+            "\" instead of \"" + symbol + "\"";
+      return -1;
+   }
+
+   Node node;
+   node.type   = QUERY_NODE_COMPARE;
+   node.left   = -1;
+   node.right  = -1;
+   node.op     = op;
+   if (!parseValue(field, tokens[position + 2], node.value)) {
+      return -1;
+   }
+   node.column = addColumn(aLocale, field);
+   nodes.push_back(node);
+   position += 3;
+   return (int)nodes.size() - 1;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::parseNot -- read "not term", "(predicate)" or a comparison.
+//     Returns the node, or -1 on an error.
+//
+
+int DateQuery::parseNot(void) {
+   if (position >= tokens.size()) {
+      error = "the predicate ends too soon";
+      return -1;
+   }
+   const string& token = tokens[position];
+   if (strcasecmp(token.c_str(), "not") == 0 || token == "!") {
+      position++;
+      int operand = parseNot();
+      if (operand < 0) {
+         return -1;
+      }
+      Node node;
+      node.type   = QUERY_NODE_NOT;
+      node.left   = operand;
+      node.right  = -1;
+      node.column = -1;
+      node.op     = -1;
+      node.value  = 0;
+      nodes.push_back(node);
+      return (int)nodes.size() - 1;
+   } else if (token == "(") {
+      position++;
+      int inside = parseOr();
+      if (inside < 0) {
+         return -1;
+      }
+      if (position >= tokens.size() || tokens[position] != ")") {
+         error = "missing \")\"";
+         return -1;
+      }
+      position++;
+      return inside;
+   }
+   return parseCompare();
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::parseOr -- read terms joined by "or".  Returns the node, or
+//     -1 on an error.
+//
+
+int DateQuery::parseOr(void) {
+   int left = parseAnd();
+   while (left >= 0 && position < tokens.size() &&
+         (strcasecmp(tokens[position].c_str(), "or") == 0 ||
+          tokens[position] == "||")) {
+      position++;
+      int right = parseAnd();
+      if (right < 0) {
+         return -1;
+      }
+      Node node;
+      node.type   = QUERY_NODE_OR;
+      node.left   = left;
+      node.right  = right;
+      node.column = -1;
+      node.op     = -1;
+      node.value  = 0;
+      nodes.push_back(node);
+      left = (int)nodes.size() - 1;
+   }
+   return left;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::parseValue -- read the value compared with a field.
+//     Returns 0 if the value cannot be read.
+//
+
+int DateQuery::parseValue(int field, const string& word, int& value) {
+   char* end;
+   long number = strtol(word.c_str(), &end, 10);
+   if (!word.empty() && *end == '\0') {
+      value = (int)number;
+      return 1;
+   }
+   if (field == QUERY_FIELD_WEEKDAY && word.size() >= 3) {
+      for (int i=0; weekdayNames[i] != NULL; i++) {
+         if (strncasecmp(word.c_str(), weekdayNames[i], word.size()) == 0) {
+            value = i;
+            return 1;
+         }
+      }
+   } else if (field == QUERY_FIELD_MONTH) {
+      value = DateParser::lookupMonth(word.c_str());
+      if (value != 0) {
+         return 1;
+      }
+   } else if (field == QUERY_FIELD_CALENDAR) {
+      if (strcasecmp(word.c_str(), "julian") == 0) {
+         value = 0;
+         return 1;
+      } else if (strcasecmp(word.c_str(), "gregorian") == 0) {
+         value = 1;
+         return 1;
+      }
+   }
+   error = "cannot read \"" + word + "\" as a " + fieldNames[field];
+   return 0;
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::scan -- add the matching days of spans (pairs of first day
+//     and number of days) to matches.  The columns of each block are
+//     filled by walking a DayCursor for each locale used.
+//
+
+void DateQuery::scan(const int* spans, int spanCount, vector<int>& matches)
+      const {
+   vector<int> locales;
+   vector<int> cursorIndex(columns.size());
+   for (size_t c=0; c<columns.size(); c++) {
+      int aLocale = columns[c].locale == LOCALE_UNKNOWN ? locale :
+            columns[c].locale;
+      size_t k = 0;
+      while (k < locales.size() && locales[k] != aLocale) {
+         k++;
+      }
+      if (k == locales.size()) {
+         locales.push_back(aLocale);
+      }
+      cursorIndex[c] = (int)k;
+   }
+   vector<vector<int> > values(columns.size(),
+         vector<int>(QUERY_BLOCK_DAYS));
+   vector<DayCursor> cursors(locales.size());
+   unsigned char mask[QUERY_BLOCK_DAYS];
+
+   for (int s=0; s<spanCount; s++) {
+      int first = spans[2 * s];
+      int count = spans[2 * s + 1];
+      for (size_t k=0; k<locales.size(); k++) {
+         cursors[k].setNiceneDay(locales[k], first);
+      }
+      for (int start=0; start<count; start+=QUERY_BLOCK_DAYS) {
+         int n = count - start;
+         if (n > QUERY_BLOCK_DAYS) {
+            n = QUERY_BLOCK_DAYS;
+         }
+         for (int i=0; i<n; i++) {
+            for (size_t c=0; c<columns.size(); c++) {
+               const DayCursor& cursor = cursors[cursorIndex[c]];
+               int value = 0;
+               switch (columns[c].field) {
+                  case QUERY_FIELD_WEEKDAY:
+                     value = cursor.getWeekday();
+                     break;
+                  case QUERY_FIELD_DAY:
+                     value = cursor.getDay();
+                     break;
+                  case QUERY_FIELD_MONTH:
+                     value = cursor.getMonth();
+                     break;
+                  case QUERY_FIELD_YEAR:
+                     value = cursor.getYear();
+                     break;
+                  case QUERY_FIELD_CALENDAR:
+                     value = cursor.getCalendar() == CALENDAR_GREGORIAN;
+                     break;
+               }
+               values[c][i] = value;
+            }
+            for (size_t k=0; k<cursors.size(); k++) {
+               cursors[k].nextDay();
+            }
+         }
+         evaluate(root, &values[0], n, mask);
+         for (int i=0; i<n; i++) {
+            if (mask[i]) {
+               matches.push_back(first + start + i);
+            }
+         }
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DateQuery::tokenize -- split a predicate into names, numbers and
+//     symbols.  Returns 0 on an unexpected character.
+//
+
+int DateQuery::tokenize(const string& expression) {
+   tokens.clear();
+   size_t i = 0;
+   while (i < expression.size()) {
+      unsigned char c = expression[i];
+      size_t start = i;
+      if (isspace(c)) {
+         i++;
+         continue;
+      } else if (isalpha(c) || c == '_') {
+         while (i < expression.size() &&
+               (isalnum((unsigned char)expression[i]) ||
+               expression[i] == '_' || expression[i] == '.')) {
+            i++;
+         }
+      } else if (isdigit(c) || (c == '-' && i + 1 < expression.size() &&
+            isdigit((unsigned char)expression[i+1]))) {
+         i++;
+         while (i < expression.size() &&
+               isdigit((unsigned char)expression[i])) {
+            i++;
+         }
+      } else if (strchr("=!<>", c) != NULL) {
+         i++;
+         if (i < expression.size() && expression[i] == '=') {
+            i++;
+         }
+      } else if ((c == '&' || c == '|') && i + 1 < expression.size() &&
+            expression[i+1] == c) {
+         i += 2;
+      } else if (c == '(' || c == ')') {
+         i++;
+      } else {
+         error = "unexpected character \"" + expression.substr(i, 1) +
+               "\" in the predicate";
+         return 0;
+      }
+      tokens.push_back(expression.substr(start, i - start));
+   }
+   if (tokens.empty()) {
+      error = "the predicate is empty";
+      return 0;
+   }
+   return 1;
+}
+
+
+
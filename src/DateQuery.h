@@ -0,0 +1,122 @@
+//
+// Creation Date: Sun Oct 18 23:38:15 PDT 2026
+// Last Modified: Sun Oct 18 23:38:15 PDT 2026
+// Filename:      DateQuery.h
+// Syntax:        C++11
+//
+// Description:   Search of a range of days for the days matching a
+//                predicate (--find), such as all Friday the 13ths in
+//                Russia:
+//                   weekday = fri and day = 13
+//                The predicate compares the fields weekday, day, month,
+//                year and calendar of each day with values, joined by
+//                and, or, not and parentheses.  A field may be qualified
+//                by a locale name, as in julian.month = dec, to use the
+//                date of the day in that locale; other fields use the
+//                locale of the query.
+//
+// The days are evaluated in blocks of QUERY_BLOCK_DAYS: the fields used
+// are filled in as columns by DayCursor walks, and each comparison and
+// each and/or/not is then a loop over the block which the compiler turns
+// into vector instructions.  When the predicate requires a day and/or a
+// month of a locale, only those days of each year are evaluated instead
+// of the whole range.  Chunks of the range are evaluated by worker
+// threads and written in order.
+//
+// Values are numbers, month names (as read by DateParser), weekday names
+// or abbreviations (sunday or sun = 0 to saturday or sat = 6), and julian
+// or gregorian for calendar.  Comparisons are =, ==, !=, <, <=, > and >=,
+// and && || ! may be used for and, or and not.
+//
+
+#ifndef _DATEQUERY_H_INCLUDED
+#define _DATEQUERY_H_INCLUDED
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Output forms:
+#define QUERY_OUTPUT_UNKNOWN  -1
+#define QUERY_OUTPUT_DAYS      0    /* date, weekday and calendar per day */
+#define QUERY_OUTPUT_YEARS     1    /* each year with a matching day     */
+#define QUERY_OUTPUT_COUNT     2    /* number of matching days           */
+
+// Number of days evaluated together:
+#define QUERY_BLOCK_DAYS      1024
+
+// Number of days in a chunk of a worker thread:
+#define QUERY_CHUNK_DAYS      16384
+
+
+class DateQuery {
+   public:
+                         DateQuery       (void);
+                        ~DateQuery       ();
+
+      int                find            (int startDay, int endDay,
+                                            FILE* output = stdout);
+      void               findDays        (int startDay, int count,
+                                            vector<int>& matches) const;
+      const string&      getError        (void) const;
+      int                parse           (const string& expression);
+      void               setLocale       (int aLocale);
+      void               setOutput       (int anOutput);
+      void               setThreadCount  (int count);
+
+      static int         getOutputByName (const char* name);
+
+   private:
+      struct Node {
+         int             type;           // QUERY_NODE_COMPARE, etc.
+         int             left;           // operand nodes, or -1
+         int             right;
+         int             column;         // compared column
+         int             op;             // QUERY_OP_EQUAL, etc.
+         int             value;          // compared value
+      };
+      struct Column {
+         int             locale;         // locale of the date
+         int             field;          // QUERY_FIELD_DAY, etc.
+      };
+
+      vector<Node>       nodes;          // parsed predicate
+      int                root;           // top node, or -1 before parse()
+      vector<Column>     columns;        // fields used by the predicate
+      int                jumpLocale;     // locale of the required day and
+      int                jumpMonth;      // month (0 if none), which are
+      int                jumpDay;        // the only days evaluated
+      int                locale;         // locale of the query
+      int                outputType;     // QUERY_OUTPUT_DAYS, etc.
+      int                threadCount;    // number of worker threads
+      string             error;          // message of the last failure
+
+      // parsing state:
+      vector<string>     tokens;
+      size_t             position;
+
+      int                addColumn       (int aLocale, int field);
+      void               evaluate        (int node, const vector<int>* values,
+                                            int count,
+                                            unsigned char* mask) const;
+      void               findJumps       (int node);
+      void               getSpans        (int startDay, int endDay,
+                                            vector<int>& spans) const;
+      int                parseAnd        (void);
+      int                parseCompare    (void);
+      int                parseNot        (void);
+      int                parseOr         (void);
+      int                parseValue      (int field, const string& word,
+                                            int& value);
+      void               scan            (const int* spans, int spanCount,
+                                            vector<int>& matches) const;
+      int                tokenize        (const string& expression);
+};
+
+
+#endif  // _DATEQUERY_H_INCLUDED
+
+
+
@@ -0,0 +1,301 @@
+//
+// Creation Date: Sun Oct 18 17:31:12 PDT 2026
+// Last Modified: Sun Oct 18 17:31:12 PDT 2026
+// Filename:      DayCursor.cpp
+// Syntax:        C++11
+//
+// Description:   Iterator over the days of a locale.
+//
+
+#include "Calendar.h"
+#include "DayCursor.h"
+
+
+//////////////////////////////
+//
+// DayCursor::DayCursor -- the default cursor is 1 January 2000 in the
+//     Gregorian calendar.
+//
+
+DayCursor::DayCursor(void) {
+   setDate(LOCALE_GREGORIAN, 2000, 1, 1);
+}
+
+
+DayCursor::DayCursor(int aLocale, int aNiceneDay) {
+   setNiceneDay(aLocale, aNiceneDay);
+}
+
+
+DayCursor::DayCursor(int aLocale, int aYear, int aMonth, int aDay) {
+   setDate(aLocale, aYear, aMonth, aDay);
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::~DayCursor --
+//
+
+DayCursor::~DayCursor() { }
+
+
+
+//////////////////////////////
+//
+// DayCursor::addDays -- move the cursor by delta days (which may be
+//     negative).  Moves within the same calendar are done by carrying
+//     into the month and year; a move across the reform day is converted
+//     from the Nicene day.
+//
+
+void DayCursor::addDays(int delta) {
+   int target = nday + delta;
+   int targetCalendar = CALENDAR_JULIAN;
+   if (target >= locale && locale != LOCALE_JULIAN) {
+      targetCalendar = CALENDAR_GREGORIAN;
+   }
+   if (targetCalendar != calendar || delta > 366 || delta < -366) {
+      nday = target;
+      update();
+      return;
+   }
+
+   nday = target;
+   weekday = ((weekday + delta) % 7 + 7) % 7;
+   day += delta;
+   while (day > length) {
+      day -= length;
+      if (++month > 12) {
+         month = 1;
+         year++;
+      }
+      length = Calendar::monthLength(calendar, year, month);
+   }
+   while (day < 1) {
+      if (--month < 1) {
+         month = 12;
+         year--;
+      }
+      length = Calendar::monthLength(calendar, year, month);
+      day += length;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::getCalendar -- CALENDAR_JULIAN or CALENDAR_GREGORIAN,
+//     whichever is in use in the locale on the current day.
+//
+
+int DayCursor::getCalendar(void) const {
+   return calendar;
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::getDay -- the day of the month.
+//
+
+int DayCursor::getDay(void) const {
+   return day;
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::getLocale --
+//
+
+int DayCursor::getLocale(void) const {
+   return locale;
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::getMonth -- the month, 1 = January.
+//
+
+int DayCursor::getMonth(void) const {
+   return month;
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::getNiceneDay --
+//
+
+int DayCursor::getNiceneDay(void) const {
+   return nday;
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::getWeekday -- the day of the week, where 0 = Sunday,
+//     1 = Monday, etc.
+//
+
+int DayCursor::getWeekday(void) const {
+   return weekday;
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::getYear --
+//
+
+int DayCursor::getYear(void) const {
+   return year;
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::nextDay -- move to the following day of the locale.
+//
+
+void DayCursor::nextDay(void) {
+   nday++;
+   if (nday == locale && locale != LOCALE_JULIAN) {
+      update();
+      return;
+   }
+   if (++weekday == 7) {
+      weekday = 0;
+   }
+   if (++day > length) {
+      day = 1;
+      if (++month > 12) {
+         month = 1;
+         year++;
+      }
+      length = Calendar::monthLength(calendar, year, month);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::nextMonth -- move to the same day of the following month,
+//     or to the last day of that month if it is shorter.  The date is
+//     placed in the locale in the same way as Calendar::setDate(), so a
+//     day dropped by the reform lands on a later day.
+//
+
+void DayCursor::nextMonth(void) {
+   int nextYear = year;
+   int nextMonth = month + 1;
+   if (nextMonth > 12) {
+      nextMonth = 1;
+      nextYear++;
+   }
+   int nextDay = day;
+   int nextLength = Calendar::monthLength(calendar, nextYear, nextMonth);
+   if (nextDay > nextLength) {
+      nextDay = nextLength;
+   }
+   setDate(locale, nextYear, nextMonth, nextDay);
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::nextWeek -- move forward seven days.
+//
+
+void DayCursor::nextWeek(void) {
+   addDays(7);
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::previousDay -- move to the preceding day of the locale.
+//
+
+void DayCursor::previousDay(void) {
+   nday--;
+   if (nday == locale - 1 && locale != LOCALE_JULIAN) {
+      update();
+      return;
+   }
+   if (--weekday < 0) {
+      weekday = 6;
+   }
+   if (--day < 1) {
+      if (--month < 1) {
+         month = 12;
+         year--;
+      }
+      length = Calendar::monthLength(calendar, year, month);
+      day = length;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::setDate -- move to a date of the locale.  The calendar of
+//     the date is chosen in the same way as Calendar::setDate().
+//
+
+void DayCursor::setDate(int aLocale, int aYear, int aMonth, int aDay) {
+   int aCalendar = Calendar::getCalendar(aLocale, aYear, aMonth, aDay);
+   setNiceneDay(aLocale, Calendar::niceneDay(aCalendar, aYear, aMonth, aDay));
+}
+
+
+
+//////////////////////////////
+//
+// DayCursor::setNiceneDay -- move to a Nicene day of the locale.
+//
+
+void DayCursor::setNiceneDay(int aLocale, int aNiceneDay) {
+   locale = aLocale;
+   nday = aNiceneDay;
+   update();
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// DayCursor::update -- recompute all fields from the Nicene day.
+//
+
+void DayCursor::update(void) {
+   Calendar::getDate(locale, nday, year, month, day);
+   calendar = CALENDAR_JULIAN;
+   if (nday >= locale && locale != LOCALE_JULIAN) {
+      calendar = CALENDAR_GREGORIAN;
+   }
+   weekday = ((nday % 7 - 1) + 14) % 7;
+   length = Calendar::monthLength(calendar, year, month);
+}
+
+
+
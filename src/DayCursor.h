@@ -0,0 +1,61 @@
+//
+// Creation Date: Sun Oct 18 17:31:12 PDT 2026
+// Last Modified: Sun Oct 18 17:31:12 PDT 2026
+// Filename:      DayCursor.h
+// Syntax:        C++11
+//
+// Description:   Iterator over the days of a locale.  The cursor carries
+//                the Nicene day together with its year, month, day,
+//                weekday and calendar, and updates them incrementally as
+//                it moves, so walking a range costs a few additions per
+//                day.  The full conversion is only needed when the
+//                cursor crosses the locale's reform day, which is how the
+//                dropped days are skipped.
+//
+
+#ifndef _DAYCURSOR_H_INCLUDED
+#define _DAYCURSOR_H_INCLUDED
+
+
+class DayCursor {
+   public:
+                         DayCursor       (void);
+                         DayCursor       (int aLocale, int aNiceneDay);
+                         DayCursor       (int aLocale, int year, int month,
+                                            int day);
+                        ~DayCursor       ();
+
+      void               addDays         (int delta);
+      int                getCalendar     (void) const;
+      int                getDay          (void) const;
+      int                getLocale       (void) const;
+      int                getMonth        (void) const;
+      int                getNiceneDay    (void) const;
+      int                getWeekday      (void) const;
+      int                getYear         (void) const;
+      void               nextDay         (void);
+      void               nextMonth       (void);
+      void               nextWeek        (void);
+      void               previousDay     (void);
+      void               setDate         (int aLocale, int year, int month,
+                                            int day);
+      void               setNiceneDay    (int aLocale, int aNiceneDay);
+
+   private:
+      int                locale;         // locale for calendar determination
+      int                nday;           // Nicene day
+      int                year;           // year of nday in its calendar
+      int                month;          // month of nday (1-12)
+      int                day;            // day of the month of nday
+      int                weekday;        // 0 = Sunday ... 6 = Saturday
+      int                calendar;       // CALENDAR_JULIAN or _GREGORIAN
+      int                length;         // number of days in month
+
+      void               update          (void);
+};
+
+
+#endif  // _DAYCURSOR_H_INCLUDED
+
+
+
@@ -0,0 +1,291 @@
+//
+// Creation Date: Sun Oct 18 21:47:12 PDT 2026
+// Last Modified: Sun Oct 18 21:47:12 PDT 2026
+// Filename:      DayTable.cpp
+// Syntax:        C++11
+//
+// Description:   Table of the Julian and Gregorian dates of every Nicene
+//                day over the historical range.  See DayTable.h.
+//
+
+#include "ByteOrder.h"
+#include "Calendar.h"
+#include "DayCursor.h"
+#include "DayTable.h"
+#include "Trace.h"
+#include "Workers.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// DayTable::DayTable --
+//
+
+DayTable::DayTable(void) {
+   records     = NULL;
+   firstDay    = 0;
+   count       = 0;
+   mapping     = NULL;
+   mappingSize = 0;
+}
+
+
+
+//////////////////////////////
+//
+// DayTable::~DayTable --
+//
+
+DayTable::~DayTable() {
+   release();
+}
+
+
+
+//////////////////////////////
+//
+// DayTable::build -- fill the table, with each of threadCount worker
+//     threads walking a range of the days, or one thread for each
+//     hardware thread if threadCount is less than 1.
+//
+
+void DayTable::build(int threadCount) {
+   release();
+   firstDay = Calendar::niceneDay(CALENDAR_GREGORIAN, DAYTABLE_FIRST_YEAR,
+         1, 1);
+   count = Calendar::niceneDay(CALENDAR_GREGORIAN, DAYTABLE_LAST_YEAR, 12,
+         31) - firstDay + 1;
+   storage.resize(count);
+   if (threadCount < 1) {
+      threadCount = Workers::getDefaultThreadCount();
+   }
+
+   Workers::run(threadCount, [&](int t) {
+      int start = (int)((long long)count * t / threadCount);
+      int end = (int)((long long)count * (t + 1) / threadCount);
+      TraceSpan span("buildDayTable", "day", start);
+      DayCursor gregorian(LOCALE_GREGORIAN, firstDay + start);
+      DayCursor julian(LOCALE_JULIAN, firstDay + start);
+      for (int i=start; i<end; i++) {
+         storage[i] = pack(gregorian.getYear(), gregorian.getMonth(),
+               gregorian.getDay(), julian.getMonth(), julian.getDay());
+         gregorian.nextDay();
+         julian.nextDay();
+      }
+   }, "daytable");
+   records = &storage[0];
+}
+
+
+
+//////////////////////////////
+//
+// DayTable::getCount -- the number of days in the table.
+//
+
+int DayTable::getCount(void) const {
+   return count;
+}
+
+
+
+//////////////////////////////
+//
+// DayTable::getFirstDay -- the Nicene day of the first record.
+//
+
+int DayTable::getFirstDay(void) const {
+   return firstDay;
+}
+
+
+
+//////////////////////////////
+//
+// DayTable::getRecords -- the records, or NULL if the table has not been
+//     built or opened.
+//
+
+const unsigned int* DayTable::getRecords(void) const {
+   return records;
+}
+
+
+
+//////////////////////////////
+//
+// DayTable::open -- map a table file written by save().  Returns 0 if
+//     the file cannot be read, is not a table file of the years
+//     DAYTABLE_FIRST_YEAR to DAYTABLE_LAST_YEAR, or has a record with a
+//     field out of range (see checkRecords()).  On big-endian hosts the
+//     records are copied instead.
+//
+
+int DayTable::open(const string& filename) {
+   int fd = ::open(filename.c_str(), O_RDONLY);
+   if (fd < 0) {
+      return 0;
+   }
+   struct stat info;
+   if (fstat(fd, &info) != 0 || info.st_size < DAYTABLE_HEADER_SIZE) {
+      close(fd);
+      return 0;
+   }
+   size_t size = info.st_size;
+   void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (map == MAP_FAILED) {
+      return 0;
+   }
+   const char* p = (const char*)map;
+   unsigned int days = readUint32(p + 16);
+   if (memcmp(p, "HCALDAY1", 8) != 0 || readUint32(p + 8) != 1 ||
+         days > 0x7fffffff ||
+         (unsigned long long)days * 4 + DAYTABLE_HEADER_SIZE != size) {
+      munmap(map, size);
+      return 0;
+   }
+
+   int first = Calendar::niceneDay(CALENDAR_GREGORIAN, DAYTABLE_FIRST_YEAR,
+         1, 1);
+   int last = Calendar::niceneDay(CALENDAR_GREGORIAN, DAYTABLE_LAST_YEAR, 12,
+         31);
+   if ((int)readUint32(p + 12) != first || days != (unsigned int)(last -
+         first + 1)) {
+      munmap(map, size);
+      return 0;
+   }
+
+   release();
+   firstDay = first;
+   count = (int)days;
+   if (bigEndianHost()) {
+      storage.resize(count);
+      for (int i=0; i<count; i++) {
+         storage[i] = readUint32(p + DAYTABLE_HEADER_SIZE + 4 * i);
+      }
+      munmap(map, size);
+      records = count > 0 ? &storage[0] : NULL;
+   } else {
+      mapping = map;
+      mappingSize = size;
+      records = (const unsigned int*)(p + DAYTABLE_HEADER_SIZE);
+   }
+   if (!checkRecords()) {
+      release();
+      return 0;
+   }
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// DayTable::pack -- make a record from the Gregorian and Julian dates of
+//     a day.
+//
+
+unsigned int DayTable::pack(int gregorianYear, int gregorianMonth,
+      int gregorianDay, int julianMonth, int julianDay) {
+   return ((unsigned int)gregorianYear << 18) |
+         ((unsigned int)gregorianMonth << 14) |
+         ((unsigned int)gregorianDay << 9) |
+         ((unsigned int)julianMonth << 5) | (unsigned int)julianDay;
+}
+
+
+
+//////////////////////////////
+//
+// DayTable::save -- write the table to a file.  Returns the exit status
+//     for the program.
+//
+
+int DayTable::save(const string& filename) const {
+   FILE* output = fopen(filename.c_str(), "wb");
+   if (output == NULL) {
+      return 1;
+   }
+   char header[DAYTABLE_HEADER_SIZE];
+   memset(header, 0, DAYTABLE_HEADER_SIZE);
+   memcpy(header, "HCALDAY1", 8);
+   writeUint32(header + 8, 1);
+   writeUint32(header + 12, (unsigned int)firstDay);
+   writeUint32(header + 16, (unsigned int)count);
+   fwrite(header, 1, DAYTABLE_HEADER_SIZE, output);
+
+   char buffer[4096];
+   for (int i=0; i<count; i+=1024) {
+      int n = count - i < 1024 ? count - i : 1024;
+      for (int k=0; k<n; k++) {
+         writeUint32(buffer + 4 * k, records[i + k]);
+      }
+      fwrite(buffer, 4, n, output);
+   }
+   if (ferror(output) | fclose(output)) {
+      return 1;
+   }
+   return 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// DayTable::checkRecords -- returns true if every record has a year in
+//     the range of the table, months of 1-12 and days of 1-31, so that
+//     the dates of a damaged file cannot index past the month tables of
+//     Calendar.  The record of each day is not compared with the
+//     arithmetic, which would cost as much as building the table.
+//
+
+int DayTable::checkRecords(void) const {
+   for (int i=0; i<count; i++) {
+      unsigned int record = records[i];
+      unsigned int year = record >> 18;
+      unsigned int gregorianMonth = (record >> 14) & 0xf;
+      unsigned int gregorianDay = (record >> 9) & 0x1f;
+      unsigned int julianMonth = (record >> 5) & 0xf;
+      unsigned int julianDay = record & 0x1f;
+      if (year < DAYTABLE_FIRST_YEAR || year > DAYTABLE_LAST_YEAR ||
+            gregorianMonth < 1 || gregorianMonth > 12 || gregorianDay < 1 ||
+            julianMonth < 1 || julianMonth > 12 || julianDay < 1) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// DayTable::release -- forget the current records.
+//
+
+void DayTable::release(void) {
+   if (mapping != NULL) {
+      munmap(mapping, mappingSize);
+   }
+   mapping     = NULL;
+   mappingSize = 0;
+   records     = NULL;
+   count       = 0;
+   vector<unsigned int>().swap(storage);
+}
+
+
+
@@ -0,0 +1,125 @@
+//
+// Creation Date: Sun Oct 18 21:47:12 PDT 2026
+// Last Modified: Sun Oct 18 21:47:12 PDT 2026
+// Filename:      DayTable.h
+// Syntax:        C++11
+//
+// Description:   Table of the Julian and Gregorian dates of every Nicene
+//                day of the Gregorian years DAYTABLE_FIRST_YEAR to
+//                DAYTABLE_LAST_YEAR, one 32-bit record per day (about
+//                14.6 MB).  When given to Calendar::setDayTable(), a
+//                Nicene day in the table is converted to a date with one
+//                load instead of arithmetic (--engine table).  The table
+//                is built by worker threads or mapped from a file written
+//                by save() (--day-table).
+//
+// A record holds, from the high bits down:
+//    bits 18-31  Gregorian year
+//    bits 14-17  Gregorian month
+//    bits  9-13  Gregorian day
+//    bits  5-8   Julian month
+//    bits  0-4   Julian day
+// The Julian year is the Gregorian year or the one before or after it,
+// which is told by comparing the months.  The weekday (one modulo of the
+// Nicene day) and the leap years (tests of the year) are not stored.
+//
+// A table file is a DAYTABLE_HEADER_SIZE byte header followed by the
+// records, all little-endian:
+//    offset  0  char[8]  "HCALDAY1"
+//    offset  8  uint32   version (1)
+//    offset 12  int32    Nicene day of the first record
+//    offset 16  uint32   number of records
+//    offset 20  uint32   zero
+//
+
+#ifndef _DAYTABLE_H_INCLUDED
+#define _DAYTABLE_H_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Gregorian years covered by the table:
+#define DAYTABLE_FIRST_YEAR      1
+#define DAYTABLE_LAST_YEAR       9999
+
+// Size of the header of a table file:
+#define DAYTABLE_HEADER_SIZE     24
+
+
+class DayTable {
+   public:
+                         DayTable        (void);
+                        ~DayTable        ();
+
+      void               build           (int threadCount);
+      int                getCount        (void) const;
+      int                getFirstDay     (void) const;
+      const unsigned int* getRecords     (void) const;
+      int                open            (const string& filename);
+      int                save            (const string& filename) const;
+
+      static void        getGregorian    (unsigned int record, int& year,
+                                            int& month, int& day);
+      static void        getJulian       (unsigned int record, int niceneDay,
+                                            int& year, int& month, int& day);
+      static unsigned int pack           (int gregorianYear,
+                                            int gregorianMonth,
+                                            int gregorianDay,
+                                            int julianMonth, int julianDay);
+
+   private:
+      const unsigned int* records;       // one record per day
+      int                firstDay;       // Nicene day of records[0]
+      int                count;          // number of records
+      vector<unsigned int> storage;      // records when not mapped
+      void*              mapping;        // mapped file, or NULL
+      size_t             mappingSize;    // size of the mapped file
+
+      int                checkRecords    (void) const;
+      void               release         (void);
+};
+
+
+
+//////////////////////////////
+//
+// DayTable::getGregorian -- the Gregorian date of a record.
+//
+
+inline void DayTable::getGregorian(unsigned int record, int& year,
+      int& month, int& day) {
+   year  = (int)(record >> 18);
+   month = (int)((record >> 14) & 0xf);
+   day   = (int)((record >> 9) & 0x1f);
+}
+
+
+
+//////////////////////////////
+//
+// DayTable::getJulian -- the Julian date of the record of niceneDay.
+//     Before Nicene day 0 the Julian date is ahead of the Gregorian
+//     date, and afterwards it is behind (or the same).
+//
+
+inline void DayTable::getJulian(unsigned int record, int niceneDay,
+      int& year, int& month, int& day) {
+   int gregorianMonth = (int)((record >> 14) & 0xf);
+   year  = (int)(record >> 18);
+   month = (int)((record >> 5) & 0xf);
+   day   = (int)(record & 0x1f);
+   if (niceneDay < 0) {
+      year += month < gregorianMonth;
+   } else {
+      year -= month > gregorianMonth;
+   }
+}
+
+
+#endif  // _DAYTABLE_H_INCLUDED
+
+
+
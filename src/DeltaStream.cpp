@@ -0,0 +1,400 @@
+//
+// Creation Date: Sun Oct 18 19:32:07 PDT 2026
+// Last Modified: Sun Oct 18 19:32:07 PDT 2026
+// Filename:      DeltaStream.cpp
+// Syntax:        C++11
+//
+// Description:   Compact encoding of sequences of Nicene days.  See
+//                DeltaStream.h for the layout.
+//
+
+#include "ByteOrder.h"
+#include "DeltaStream.h"
+#include <cstring>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// DeltaWriter::DeltaWriter --
+//
+
+DeltaWriter::DeltaWriter(void) {
+   file       = NULL;
+   offset     = 0;
+   valueCount = 0;
+}
+
+
+
+//////////////////////////////
+//
+// DeltaWriter::~DeltaWriter --
+//
+
+DeltaWriter::~DeltaWriter() { }
+
+
+
+//////////////////////////////
+//
+// DeltaWriter::close -- write the index and trailer.  Returns the exit
+//     status for the program.
+//
+
+int DeltaWriter::close(void) {
+   unsigned long long indexOffset = offset;
+   char entry[DELTA_INDEX_ENTRY];
+   for (size_t i=0; i+1<index.size(); i+=2) {
+      writeUint64(entry, index[i]);
+      writeUint64(entry + 8, index[i+1]);
+      fwrite(entry, 1, DELTA_INDEX_ENTRY, file);
+   }
+   char trailer[DELTA_TRAILER_SIZE];
+   writeUint64(trailer, indexOffset);
+   writeUint64(trailer + 8, valueCount);
+   writeUint32(trailer + 16, (unsigned int)(index.size() / 2));
+   memcpy(trailer + 20, "DLTX", 4);
+   fwrite(trailer, 1, DELTA_TRAILER_SIZE, file);
+   fflush(file);
+   return ferror(file) ? 1 : 0;
+}
+
+
+
+//////////////////////////////
+//
+// DeltaWriter::open -- start a stream by writing the header.
+//
+
+void DeltaWriter::open(FILE* output) {
+   file = output;
+   char header[DELTA_HEADER_SIZE];
+   memcpy(header, "HCALDLT1", 8);
+   writeUint32(header + 8, 1);
+   writeUint32(header + 12, DELTA_BLOCK_VALUES);
+   fwrite(header, 1, DELTA_HEADER_SIZE, file);
+   offset = DELTA_HEADER_SIZE;
+   valueCount = 0;
+   index.clear();
+}
+
+
+
+//////////////////////////////
+//
+// DeltaWriter::write -- write blocks made by encode(), adding them to
+//     the index.
+//
+
+void DeltaWriter::write(const string& blocks) {
+   const char* p = blocks.data();
+   const char* end = p + blocks.size();
+   while (p + DELTA_BLOCK_HEADER <= end) {
+      index.push_back(offset + (p - blocks.data()));
+      index.push_back(valueCount);
+      valueCount += readUint32(p + 4);
+      p += DELTA_BLOCK_HEADER + readUint32(p + 8);
+   }
+   fwrite(blocks.data(), 1, blocks.size(), file);
+   offset += blocks.size();
+}
+
+
+
+//////////////////////////////
+//
+// DeltaWriter::encode -- append count values to output as blocks of at
+//     most DELTA_BLOCK_VALUES values.
+//
+
+void DeltaWriter::encode(const int* values, int count, string& output) {
+   size_t length = output.size();
+   output.resize(length + (size_t)count * 5 +
+         ((size_t)count / DELTA_BLOCK_VALUES + 1) * DELTA_BLOCK_HEADER);
+   char* p = &output[length];
+   for (int start=0; start<count; start+=DELTA_BLOCK_VALUES) {
+      int n = count - start;
+      if (n > DELTA_BLOCK_VALUES) {
+         n = DELTA_BLOCK_VALUES;
+      }
+      char* header = p;
+      p += DELTA_BLOCK_HEADER;
+      unsigned int previous = (unsigned int)values[start];
+      for (int i=start+1; i<start+n; i++) {
+         unsigned int delta = (unsigned int)values[i] - previous;
+         previous = (unsigned int)values[i];
+         unsigned int zigzag = (delta << 1) ^ (unsigned int)((int)delta >> 31);
+         while (zigzag >= 0x80) {
+            *p++ = (char)(zigzag | 0x80);
+            zigzag >>= 7;
+         }
+         *p++ = (char)zigzag;
+      }
+      writeUint32(header, (unsigned int)values[start]);
+      writeUint32(header + 4, (unsigned int)n);
+      writeUint32(header + 8, (unsigned int)(p - header - DELTA_BLOCK_HEADER));
+   }
+   output.resize(p - &output[0]);
+}
+
+
+
+//////////////////////////////
+//
+// DeltaReader::DeltaReader --
+//
+
+DeltaReader::DeltaReader(void) {
+   data       = NULL;
+   size       = 0;
+   index      = NULL;
+   blockCount = 0;
+   count      = 0;
+}
+
+
+
+//////////////////////////////
+//
+// DeltaReader::~DeltaReader --
+//
+
+DeltaReader::~DeltaReader() { }
+
+
+
+//////////////////////////////
+//
+// DeltaReader::decodeBlocks -- decode the blocks firstBlock to lastBlock
+//     inclusive into output, which has room for capacity values.  Returns
+//     the number of values decoded.  A corrupt block, whose payload ends
+//     before its values do or which has a varint that is cut off or
+//     longer than 5 bytes, is left out and decoding goes on with the next
+//     block, so fewer values are returned than the headers count.
+//     Decoding stops at a block which does not fit in the rest of output.
+//
+
+int DeltaReader::decodeBlocks(int firstBlock, int lastBlock, int* output,
+      int capacity) const {
+   int k = 0;
+   for (int b=firstBlock; b<=lastBlock; b++) {
+      const char* p = getBlock(b);
+      unsigned int value = readUint32(p);
+      int n = (int)readUint32(p + 4);
+      if (n > capacity - k) {
+         return k;
+      }
+      const unsigned char* q = (const unsigned char*)p + DELTA_BLOCK_HEADER;
+      const unsigned char* end = q + readUint32(p + 8);
+      int start = k;
+      int corrupt = 0;
+      output[k++] = (int)value;
+      for (int i=1; i<n; i++) {
+         if (q >= end) {
+            corrupt = 1;
+            break;
+         }
+         unsigned int zigzag = *q++;
+         if (zigzag >= 0x80) {
+            zigzag &= 0x7f;
+            int shift = 7;
+            unsigned int byte;
+            do {
+               if (q >= end || shift >= 35) {
+                  corrupt = 1;
+                  break;
+               }
+               byte = *q++;
+               zigzag |= (byte & 0x7f) << shift;
+               shift += 7;
+            } while (byte >= 0x80);
+            if (corrupt) {
+               break;
+            }
+         }
+         value += (zigzag >> 1) ^ (0u - (zigzag & 1));
+         output[k++] = (int)value;
+      }
+      if (corrupt) {
+         k = start;
+      }
+   }
+   return k;
+}
+
+
+
+//////////////////////////////
+//
+// DeltaReader::findBlock -- returns the block holding the given value
+//     number (counting from 0).
+//
+
+int DeltaReader::findBlock(unsigned long long value) const {
+   int low = 0;
+   int high = blockCount - 1;
+   while (low < high) {
+      int middle = (low + high + 1) / 2;
+      if (getBlockStart(middle) <= value) {
+         low = middle;
+      } else {
+         high = middle - 1;
+      }
+   }
+   return low;
+}
+
+
+
+//////////////////////////////
+//
+// DeltaReader::getBlockCount --
+//
+
+int DeltaReader::getBlockCount(void) const {
+   return blockCount;
+}
+
+
+
+//////////////////////////////
+//
+// DeltaReader::getBlockStart -- the number of values before the block.
+//     The block count is returned for block = getBlockCount().
+//
+
+unsigned long long DeltaReader::getBlockStart(int block) const {
+   if (block >= blockCount) {
+      return count;
+   }
+   return readUint64(index + (size_t)block * DELTA_INDEX_ENTRY + 8);
+}
+
+
+
+//////////////////////////////
+//
+// DeltaReader::getCount -- the total number of values.
+//
+
+unsigned long long DeltaReader::getCount(void) const {
+   return count;
+}
+
+
+
+//////////////////////////////
+//
+// DeltaReader::open -- use a delta stream held in memory, such as a
+//     memory-mapped file.  Returns 0 if the data is not a valid stream.
+//
+
+int DeltaReader::open(const char* someData, size_t aSize) {
+   if (!isDeltaStream(someData, aSize)) {
+      return 0;
+   }
+   const char* trailer = someData + aSize - DELTA_TRAILER_SIZE;
+   unsigned long long indexOffset = readUint64(trailer);
+   unsigned int blocks = readUint32(trailer + 16);
+   if (memcmp(trailer + 20, "DLTX", 4) != 0 || blocks > 0x7fffffff ||
+         indexOffset < DELTA_HEADER_SIZE || indexOffset +
+         (unsigned long long)blocks * DELTA_INDEX_ENTRY + DELTA_TRAILER_SIZE
+         != aSize) {
+      return 0;
+   }
+   data       = someData;
+   size       = aSize;
+   index      = someData + indexOffset;
+   blockCount = (int)blocks;
+   count      = readUint64(trailer + 8);
+
+   // check that each block lies before the index, and that the value
+   // counts of the index and the trailer agree with the block headers:
+   unsigned long long start = 0;
+   for (int b=0; b<blockCount; b++) {
+      unsigned long long offset = readUint64(index + (size_t)b *
+            DELTA_INDEX_ENTRY);
+      if (offset < DELTA_HEADER_SIZE ||
+            offset > indexOffset - DELTA_BLOCK_HEADER ||
+            readUint32(data + offset + 8) > indexOffset - offset -
+            DELTA_BLOCK_HEADER || readUint32(data + offset + 4) == 0 ||
+            readUint32(data + offset + 4) > DELTA_BLOCK_VALUES ||
+            getBlockStart(b) != start) {
+         blockCount = 0;
+         count = 0;
+         return 0;
+      }
+      start += readUint32(data + offset + 4);
+   }
+   if (start != count) {
+      blockCount = 0;
+      count = 0;
+      return 0;
+   }
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// DeltaReader::read -- decode count values starting at value number
+//     first into output.  Returns the number of values read, which is
+//     less than count at the end of the stream or at a corrupt block.
+//
+
+int DeltaReader::read(unsigned long long first, int aCount,
+      int* output) const {
+   int values[DELTA_BLOCK_VALUES];
+   int k = 0;
+   if (first >= count) {
+      return 0;
+   }
+   int b = findBlock(first);
+   while (k < aCount && b < blockCount) {
+      int n = decodeBlocks(b, b, values, DELTA_BLOCK_VALUES);
+      unsigned long long start = getBlockStart(b);
+      int i = first + k > start ? (int)(first + k - start) : 0;
+      for ( ; i<n && k<aCount; i++) {
+         output[k++] = values[i];
+      }
+      if (n < (int)readUint32(getBlock(b) + 4)) {
+         break;   // corrupt block
+      }
+      b++;
+   }
+   return k;
+}
+
+
+
+//////////////////////////////
+//
+// DeltaReader::isDeltaStream -- returns true if the data starts with the
+//     header of a delta stream.
+//
+
+int DeltaReader::isDeltaStream(const char* someData, size_t aSize) {
+   return aSize >= DELTA_HEADER_SIZE + DELTA_TRAILER_SIZE &&
+         memcmp(someData, "HCALDLT1", 8) == 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// DeltaReader::getBlock -- the start of a block in the data.
+//
+
+const char* DeltaReader::getBlock(int block) const {
+   return data + readUint64(index + (size_t)block * DELTA_INDEX_ENTRY);
+}
+
+
+
@@ -0,0 +1,114 @@
+//
+// Creation Date: Sun Oct 18 19:32:07 PDT 2026
+// Last Modified: Sun Oct 18 19:32:07 PDT 2026
+// Filename:      DeltaStream.h
+// Syntax:        C++11
+//
+// Description:   Compact encoding of sequences of Nicene days (--format
+//                delta, and as input to --convert-file).  Values are
+//                stored in blocks as a base value followed by zig-zag
+//                varint deltas, so a dense, mostly increasing sequence
+//                takes about one byte per value.  An index at the end of
+//                the file gives the position of each block, so reading
+//                can start at any value after decoding at most one block.
+//
+// All integers are little-endian.  The file is laid out as:
+//    header (16 bytes):
+//       offset  0  char[8]  "HCALDLT1"
+//       offset  8  uint32   version (1)
+//       offset 12  uint32   maximum values per block (DELTA_BLOCK_VALUES)
+//    blocks, each:
+//       offset  0  int32    first value of the block
+//       offset  4  uint32   number of values in the block (at least 1)
+//       offset  8  uint32   number of bytes of deltas which follow
+//       offset 12  varints  for each value after the first, the
+//                           difference from the previous value (modulo
+//                           2^32) zig-zag encoded, 7 bits per byte, low
+//                           bits first, high bit set on all but the last
+//                           byte
+//    index, one 16-byte entry per block:
+//       offset  0  uint64   file offset of the block
+//       offset  8  uint64   number of values before the block
+//    trailer (24 bytes):
+//       offset  0  uint64   file offset of the index
+//       offset  8  uint64   total number of values
+//       offset 16  uint32   number of blocks
+//       offset 20  char[4]  "DLTX"
+// Blocks are full except where a writer flushed a partial one, so the
+// index is searched for the block containing a value.  A reader accepts
+// a file only if the value counts of the index start at 0 and grow by the
+// count of each block header, up to the total of the trailer.
+//
+
+#ifndef _DELTASTREAM_H_INCLUDED
+#define _DELTASTREAM_H_INCLUDED
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Maximum number of values in a block:
+#define DELTA_BLOCK_VALUES   4096
+
+// Sizes of the fixed parts of the format:
+#define DELTA_HEADER_SIZE    16
+#define DELTA_BLOCK_HEADER   12
+#define DELTA_INDEX_ENTRY    16
+#define DELTA_TRAILER_SIZE   24
+
+
+class DeltaWriter {
+   public:
+                         DeltaWriter     (void);
+                        ~DeltaWriter     ();
+
+      int                close           (void);
+      void               open            (FILE* output);
+      void               write           (const string& blocks);
+
+      static void        encode          (const int* values, int count,
+                                            string& output);
+
+   private:
+      FILE*              file;           // output file
+      unsigned long long offset;         // bytes written so far
+      unsigned long long valueCount;     // values written so far
+      vector<unsigned long long> index;  // offset, first value of blocks
+};
+
+
+class DeltaReader {
+   public:
+                         DeltaReader     (void);
+                        ~DeltaReader     ();
+
+      int                decodeBlocks    (int firstBlock, int lastBlock,
+                                            int* output, int capacity) const;
+      int                findBlock       (unsigned long long value) const;
+      int                getBlockCount   (void) const;
+      unsigned long long getBlockStart   (int block) const;
+      unsigned long long getCount        (void) const;
+      int                open            (const char* someData, size_t aSize);
+      int                read            (unsigned long long first, int count,
+                                            int* output) const;
+
+      static int         isDeltaStream   (const char* someData, size_t aSize);
+
+   private:
+      const char*        data;           // start of the file
+      size_t             size;           // size of the file
+      const char*        index;          // start of the index
+      int                blockCount;     // number of blocks
+      unsigned long long count;          // total number of values
+
+      const char*        getBlock        (int block) const;
+};
+
+
+#endif  // _DELTASTREAM_H_INCLUDED
+
+
+
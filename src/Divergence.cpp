@@ -0,0 +1,141 @@
+//
+// Creation Date: Mon Oct 19 00:41:27 PDT 2026
+// Last Modified: Mon Oct 19 00:41:27 PDT 2026
+// Filename:      Divergence.cpp
+// Syntax:        C++11
+//
+// Description:   Intervals of Nicene days on which two locales use
+//                different calendars.  See Divergence.h.
+//
+
+#include "Calendar.h"
+#include "Divergence.h"
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// Divergence::findOffset -- the offset of the interval holding a Nicene
+//     day, found by a binary search of sorted intervals, or 0 if no
+//     interval holds it.
+//
+
+int Divergence::findOffset(const vector<Interval>& intervals, int niceneDay) {
+   size_t low = 0;
+   size_t high = intervals.size();
+   while (low < high) {
+      size_t middle = low + (high - low) / 2;
+      if (intervals[middle].last < niceneDay) {
+         low = middle + 1;
+      } else {
+         high = middle;
+      }
+   }
+   if (low < intervals.size() && intervals[low].first <= niceneDay) {
+      return intervals[low].offset;
+   }
+   return 0;
+}
+
+
+
+//////////////////////////////
+//
+// Divergence::getIntervals -- replace intervals with the intervals of
+//     the days from startDay to endDay inclusive on which the two locales
+//     use different calendars, in increasing order.  A new interval
+//     starts wherever the offset changes.
+//
+
+void Divergence::getIntervals(int localeA, int localeB, int startDay,
+      int endDay, vector<Interval>& intervals) {
+   intervals.clear();
+
+   // the days on which exactly one of the locales is Gregorian:
+   long long reformA = localeA == LOCALE_JULIAN ? (long long)endDay + 1 :
+         localeA;
+   long long reformB = localeB == LOCALE_JULIAN ? (long long)endDay + 1 :
+         localeB;
+   long long first = reformA < reformB ? reformA : reformB;
+   long long last = (reformA < reformB ? reformB : reformA) - 1;
+   if (first < startDay) {
+      first = startDay;
+   }
+   if (last > endDay) {
+      last = endDay;
+   }
+   if (first > last) {
+      return;
+   }
+   int sign = reformB < reformA ? 1 : -1;
+
+   // split at Julian 1 March of the years divisible by 100 but not 400:
+   int year, month, day;
+   Calendar::getDate(LOCALE_JULIAN, (int)first, year, month, day);
+   int century = Calendar::floorDivide(year - 1, 100);
+   int start = (int)first;
+   while (1) {
+      century++;
+      if (century - Calendar::floorDivide(century, 4) * 4 == 0) {
+         century++;
+      }
+      int next = Calendar::niceneDay(CALENDAR_JULIAN, century * 100, 3, 1);
+      if (next <= start) {
+         continue;
+      }
+      int end = (int)last;
+      if (next - 1 < end) {
+         end = next - 1;
+      }
+      Interval interval;
+      interval.first  = start;
+      interval.last   = end;
+      interval.offset = sign * getJulianLag(start);
+      intervals.push_back(interval);
+      if (end >= last) {
+         break;
+      }
+      start = end + 1;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// Divergence::getJulianLag -- the number of days the Gregorian date of a
+//     Nicene day is ahead of its Julian date (negative before Nicene
+//     day 0).
+//
+
+int Divergence::getJulianLag(int niceneDay) {
+   int year, month, day;
+   Calendar::getDate(LOCALE_JULIAN, niceneDay, year, month, day);
+   if (month < 3) {
+      year--;
+   }
+   return Calendar::floorDivide(year, 100) -
+         Calendar::floorDivide(year, 400) - 2;
+}
+
+
+
+//////////////////////////////
+//
+// Divergence::getOffset -- the number of days the date of a Nicene day in
+//     localeB is ahead of its date in localeA.
+//
+
+int Divergence::getOffset(int localeA, int localeB, int niceneDay) {
+   int calendarA = Calendar::getCalendar(localeA, niceneDay);
+   int calendarB = Calendar::getCalendar(localeB, niceneDay);
+   if (calendarA == calendarB) {
+      return 0;
+   }
+   int lag = getJulianLag(niceneDay);
+   return calendarB == CALENDAR_GREGORIAN ? lag : -lag;
+}
+
+
+
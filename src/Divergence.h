@@ -0,0 +1,52 @@
+//
+// Creation Date: Mon Oct 19 00:41:27 PDT 2026
+// Last Modified: Mon Oct 19 00:41:27 PDT 2026
+// Filename:      Divergence.h
+// Syntax:        C++11
+//
+// Description:   Intervals of Nicene days on which two locales use
+//                different calendars, and how many days apart their
+//                dates are (--divergence).  Two locales differ between
+//                their reform days, where one of them is still Julian
+//                and the other already Gregorian.  The Gregorian date is
+//                ahead of the Julian date by
+//                   Y/100 - Y/400 - 2
+//                days, where Y is the Julian year, less one before March
+//                (floor division), so within the interval the distance
+//                only changes on Julian 1 March of the years divisible by
+//                100 but not by 400.  The intervals are found from the
+//                reform days and these years, without scanning days.
+//
+
+#ifndef _DIVERGENCE_H_INCLUDED
+#define _DIVERGENCE_H_INCLUDED
+
+#include <vector>
+
+using namespace std;
+
+
+class Divergence {
+   public:
+      struct Interval {
+         int             first;          // first Nicene day
+         int             last;           // last Nicene day
+         int             offset;         // days the date in the second
+                                         // locale is ahead of the first
+      };
+
+      static int         findOffset      (const vector<Interval>& intervals,
+                                            int niceneDay);
+      static void        getIntervals    (int localeA, int localeB,
+                                            int startDay, int endDay,
+                                            vector<Interval>& intervals);
+      static int         getJulianLag    (int niceneDay);
+      static int         getOffset       (int localeA, int localeB,
+                                            int niceneDay);
+};
+
+
+#endif  // _DIVERGENCE_H_INCLUDED
+
+
+
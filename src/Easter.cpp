@@ -0,0 +1,129 @@
+//
+// Creation Date: Mon Oct 19 01:52:36 PDT 2026
+// Last Modified: Mon Oct 19 01:52:36 PDT 2026
+// Filename:      Easter.cpp
+// Syntax:        C++11
+//
+// Description:   Date of Easter Sunday by the Julian and the Gregorian
+//                computus.  See Easter.h.
+//
+
+#include "Calendar.h"
+#include "Easter.h"
+
+using namespace std;
+
+static inline int  gregorianEaster (int year);
+static inline int  julianEaster    (int year);
+
+
+//////////////////////////////
+//
+// Easter::fillTable -- store the Easter days (Nicene days) of count
+//     years of a locale in niceneDays, starting at firstYear.  The years
+//     must be from 1 to CALENDAR_MAX_YEAR.
+//
+
+void Easter::fillTable(int aLocale, int firstYear, int count,
+      int* niceneDays) {
+   int gregorianFrom = aLocale == LOCALE_JULIAN ? 0x7fffffff : aLocale;
+   for (int i=0; i<count; i++) {
+      int gregorian = gregorianEaster(firstYear + i);
+      int julian = julianEaster(firstYear + i);
+      niceneDays[i] = gregorian >= gregorianFrom ? gregorian : julian;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// Easter::getEaster -- the Easter day (Nicene day) of a year (1 to
+//     CALENDAR_MAX_YEAR) in a locale.
+//
+
+int Easter::getEaster(int aLocale, int year) {
+   int easter;
+   fillTable(aLocale, year, 1, &easter);
+   return easter;
+}
+
+
+
+//////////////////////////////
+//
+// Easter::getGregorianEaster -- the Nicene day of the Gregorian Easter of
+//     a year (1 to CALENDAR_MAX_YEAR).
+//
+
+int Easter::getGregorianEaster(int year) {
+   return gregorianEaster(year);
+}
+
+
+
+//////////////////////////////
+//
+// Easter::getJulianEaster -- the Nicene day of the Julian Easter of a
+//     year (1 to CALENDAR_MAX_YEAR).
+//
+
+int Easter::getJulianEaster(int year) {
+   return julianEaster(year);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// gregorianEaster -- the Meeus/Jones/Butcher algorithm, which gives
+//     Easter as month * 31 + day - 1 = h + l - 7m + 114, so Easter is
+//     h + l - 7m + 21 days after 1 March in both March and April.
+//     1 March of a Gregorian year is Nicene day
+//     365 (year - 200) + year/4 - year/100 + year/400 - 48.
+//
+
+static inline int gregorianEaster(int year) {
+   int a = year % 19;
+   int b = year / 100;
+   int c = year % 100;
+   int d = b / 4;
+   int e = b % 4;
+   int f = (b + 8) / 25;
+   int g = (b - f + 1) / 3;
+   int h = (19 * a + b - d - g + 15) % 30;
+   int i = c / 4;
+   int k = c % 4;
+   int l = (32 + 2 * e + 2 * i - h - k) % 7;
+   int m = (a + 11 * h + 22 * l) / 451;
+   int march1 = 365 * (year - 200) + year / 4 - year / 100 + year / 400 - 48;
+   return march1 + h + l - 7 * m + 21;
+}
+
+
+
+//////////////////////////////
+//
+// julianEaster -- the Meeus Julian algorithm, which gives Easter as
+//     month * 31 + day - 1 = d + e + 114, so Easter is d + e + 21 days
+//     after 1 March.  1 March of a Julian year is Nicene day
+//     365 (year - 200) + year/4 - 50.
+//
+
+static inline int julianEaster(int year) {
+   int a = year % 4;
+   int b = year % 7;
+   int c = year % 19;
+   int d = (19 * c + 15) % 30;
+   int e = (2 * a + 4 * b - d + 34) % 7;
+   int march1 = 365 * (year - 200) + year / 4 - 50;
+   return march1 + d + e + 21;
+}
+
+
+
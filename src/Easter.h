@@ -0,0 +1,39 @@
+//
+// Creation Date: Mon Oct 19 01:52:36 PDT 2026
+// Last Modified: Mon Oct 19 01:52:36 PDT 2026
+// Filename:      Easter.h
+// Syntax:        C++11
+//
+// Description:   Date of Easter Sunday by the Julian and the Gregorian
+//                computus (--easter).  A locale keeps Easter by the rule
+//                of the calendar it uses on the Gregorian Easter day, so
+//                England has the Julian Easter until 1752 and the
+//                Gregorian one from 1753.  Easter days are Nicene days,
+//                found with the Meeus algorithms as an offset from
+//                1 March of the year.
+//
+// Easter::fillTable() computes the Easter days of a range of years into
+// an array, which can be indexed by year for repeated lookups.  Each year
+// is a few lines of branch-free integer arithmetic with no calls, so the
+// loop is vectorized by the compiler at -O3.  Movable feasts
+// are fixed offsets from Easter (Ash Wednesday -46, Pentecost +49).
+//
+
+#ifndef _EASTER_H_INCLUDED
+#define _EASTER_H_INCLUDED
+
+
+class Easter {
+   public:
+      static void        fillTable       (int aLocale, int firstYear,
+                                            int count, int* niceneDays);
+      static int         getEaster       (int aLocale, int year);
+      static int         getGregorianEaster(int year);
+      static int         getJulianEaster (int year);
+};
+
+
+#endif  // _EASTER_H_INCLUDED
+
+
+
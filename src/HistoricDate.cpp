@@ -0,0 +1,269 @@
+//
+// Creation Date: Sun Oct 18 22:20:38 PDT 2026
+// Last Modified: Mon Oct 19 03:10:24 PDT 2026
+// Filename:      HistoricDate.cpp
+// Syntax:        C++11
+//
+// Description:   A date as written in a locale, packed into 32 bits.
+//
+
+#include "Calendar.h"
+#include "DateParser.h"
+#include "HistoricDate.h"
+#include "NumberFormat.h"
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+
+static_assert(sizeof(HistoricDate) == 4, "HistoricDate must pack into 32 bits");
+static_assert(is_trivially_copyable<HistoricDate>::value,
+      "HistoricDate must be trivially copyable");
+
+
+//////////////////////////////
+//
+// HistoricDate::HistoricDate -- the date of a year, month and day in a
+//     locale, in the calendar which Calendar::setDate() would choose.
+//     Exits with an error if setDate() does not accept the date.  The
+//     default date is Nicene day 0 Julian, with no locale.
+//
+
+HistoricDate::HistoricDate(void) {
+   nicene      = 0;
+   gregorian   = 0;
+   localeIndex = HISTORICDATE_NO_LOCALE;
+}
+
+
+HistoricDate::HistoricDate(int aLocale, int aYear, int aMonth, int aDay) {
+   nicene      = 0;
+   gregorian   = 0;
+   localeIndex = HISTORICDATE_NO_LOCALE;
+   if (!setDate(aLocale, aYear, aMonth, aDay)) {
+      cerr << "Error: invalid date " << aDay << " " << aMonth << " "
+           << aYear << endl;
+      exit(1);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::format -- write the date as YYYY-MM-DD in buffer and
+//     return its length.  As with snprintf(), the text is cut off to fit
+//     in size bytes with its null, and the full length is returned.
+//
+
+int HistoricDate::format(char* buffer, int size) const {
+   int aYear, aMonth, aDay;
+   getDate(aYear, aMonth, aDay);
+   char text[32];
+   int length = (int)(writeDate(text, aYear, aMonth, aDay) - text);
+   if (size > 0) {
+      int n = length < size - 1 ? length : size - 1;
+      memcpy(buffer, text, n);
+      buffer[n] = '\0';
+   }
+   return length;
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::fromNiceneDay -- the date of a Nicene day as written in
+//     a locale, in the Julian calendar if the locale is unknown (as in
+//     setDate()).  Days outside the years HISTORICDATE_MIN_YEAR to
+//     HISTORICDATE_MAX_YEAR (in both calendars) are clamped to the first
+//     or last day of that range, so they cannot overflow the packed day.
+//
+
+HistoricDate HistoricDate::fromNiceneDay(int aLocale, int aNiceneDay) {
+   static const int firstDay = Calendar::niceneDay(CALENDAR_GREGORIAN,
+         HISTORICDATE_MIN_YEAR, 1, 1);
+   static const int lastDay = Calendar::niceneDay(CALENDAR_GREGORIAN,
+         HISTORICDATE_MAX_YEAR, 12, 31);
+   if (aNiceneDay < firstDay) {
+      aNiceneDay = firstDay;
+   } else if (aNiceneDay > lastDay) {
+      aNiceneDay = lastDay;
+   }
+   int index = Calendar::getLocaleIndex(aLocale);
+   HistoricDate date;
+   date.nicene      = aNiceneDay;
+   date.gregorian   = aLocale != LOCALE_UNKNOWN &&
+                      Calendar::getCalendar(aLocale, aNiceneDay) ==
+                      CALENDAR_GREGORIAN;
+   date.localeIndex = index < 0 ? HISTORICDATE_NO_LOCALE : index;
+   return date;
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::getCalendar -- CALENDAR_JULIAN or CALENDAR_GREGORIAN.
+//
+
+int HistoricDate::getCalendar(void) const {
+   return gregorian ? CALENDAR_GREGORIAN : CALENDAR_JULIAN;
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::getDate -- the year, month and day as written.
+//
+
+void HistoricDate::getDate(int& aYear, int& aMonth, int& aDay) const {
+   Calendar::getDate(gregorian ? LOCALE_GREGORIAN : LOCALE_JULIAN, nicene,
+         aYear, aMonth, aDay);
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::getDay --
+//
+
+int HistoricDate::getDay(void) const {
+   int aYear, aMonth, aDay;
+   getDate(aYear, aMonth, aDay);
+   return aDay;
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::getHash -- hash of the day named, so that equal dates
+//     have equal hashes.
+//
+
+unsigned int HistoricDate::getHash(void) const {
+   unsigned int hash = (unsigned int)nicene * 0x9e3779b1u;
+   return hash ^ (hash >> 16);
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::getLocale -- the locale code, or LOCALE_UNKNOWN.
+//
+
+int HistoricDate::getLocale(void) const {
+   if (localeIndex == HISTORICDATE_NO_LOCALE) {
+      return LOCALE_UNKNOWN;
+   }
+   return Calendar::getLocaleByIndex(localeIndex);
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::getMonth --
+//
+
+int HistoricDate::getMonth(void) const {
+   int aYear, aMonth, aDay;
+   getDate(aYear, aMonth, aDay);
+   return aMonth;
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::getNiceneDays -- the Nicene days of count dates, to sort
+//     or compare many dates by their keys.
+//
+
+void HistoricDate::getNiceneDays(const HistoricDate* dates, int count,
+      int* output) {
+   for (int i=0; i<count; i++) {
+      output[i] = dates[i].nicene;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::getWeekday -- 0 = Sunday to 6 = Saturday.
+//
+
+int HistoricDate::getWeekday(void) const {
+   return ((nicene % 7 - 1) + 14) % 7;
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::getYear --
+//
+
+int HistoricDate::getYear(void) const {
+   int aYear, aMonth, aDay;
+   getDate(aYear, aMonth, aDay);
+   return aYear;
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::parse -- read a date in any DateParser form as written in
+//     a locale.  Returns false, leaving date unchanged, if the text is not
+//     a date or setDate() does not accept it.
+//
+
+int HistoricDate::parse(const char* text, int aLocale, HistoricDate& date) {
+   int aYear, aMonth, aDay;
+   if (!DateParser::parse(text, aYear, aMonth, aDay)) {
+      return 0;
+   }
+   return date.setDate(aLocale, aYear, aMonth, aDay);
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate::setDate -- set the date of a year, month and day in a
+//     locale, in the calendar which Calendar::setDate() would choose, and
+//     convert it to its Nicene day once.  Returns false, leaving the date
+//     unchanged, if the year is outside HISTORICDATE_MIN_YEAR to
+//     HISTORICDATE_MAX_YEAR or the month or day does not exist in that
+//     calendar.  Dates dropped by the reform of the locale are kept as
+//     written in the Julian calendar.
+//
+
+int HistoricDate::setDate(int aLocale, int aYear, int aMonth, int aDay) {
+   if (aYear < HISTORICDATE_MIN_YEAR || aYear > HISTORICDATE_MAX_YEAR ||
+         aMonth < 1 || aMonth > 12 || aDay < 1 || aDay > 31) {
+      return 0;
+   }
+   int calendar = CALENDAR_JULIAN;
+   if (aLocale != LOCALE_UNKNOWN) {
+      calendar = Calendar::getCalendar(aLocale, aYear, aMonth, aDay);
+   }
+   if (aDay > Calendar::monthLength(calendar, aYear, aMonth)) {
+      return 0;
+   }
+   int index = Calendar::getLocaleIndex(aLocale);
+   nicene      = Calendar::niceneDay(calendar, aYear, aMonth, aDay);
+   gregorian   = calendar == CALENDAR_GREGORIAN;
+   localeIndex = index < 0 ? HISTORICDATE_NO_LOCALE : index;
+   return 1;
+}
+
+
+
@@ -0,0 +1,135 @@
+//
+// Creation Date: Sun Oct 18 22:20:38 PDT 2026
+// Last Modified: Mon Oct 19 03:10:24 PDT 2026
+// Filename:      HistoricDate.h
+// Syntax:        C++11
+//
+// Description:   A date as written in a locale, packed into 32 bits so
+//                that large sets of dates can be held, copied and sorted
+//                cheaply.  The date is kept as the Nicene day it names,
+//                with the calendar it is written in and the locale index
+//                (see Calendar::getLocaleIndex()), so the year, month and
+//                day are recovered exactly.  Dates are compared and hashed
+//                by the stored Nicene day, so the same day written in
+//                different calendars or locales compares equal, and a
+//                comparison makes no calendar conversion.
+//
+// The default date is a valid sentinel: Nicene day 0 (1 March 200 in both
+// calendars), Julian, with no locale.
+//
+
+#ifndef _HISTORICDATE_H_INCLUDED
+#define _HISTORICDATE_H_INCLUDED
+
+#include <cstddef>
+#include <functional>
+
+using namespace std;
+
+// Range of years accepted by setDate() (the Calendar arithmetic starts at
+// year 1, and the Nicene days of these years fit in the 27 bits of the
+// packed day):
+#define HISTORICDATE_MIN_YEAR     1
+#define HISTORICDATE_MAX_YEAR     131071
+
+// Locale index of a date with no known locale:
+#define HISTORICDATE_NO_LOCALE    15
+
+
+class HistoricDate {
+   public:
+                         HistoricDate    (void);
+                         HistoricDate    (int aLocale, int aYear, int aMonth,
+                                            int aDay);
+
+      int                format          (char* buffer, int size) const;
+      int                getCalendar     (void) const;
+      void               getDate         (int& aYear, int& aMonth,
+                                            int& aDay) const;
+      int                getDay          (void) const;
+      unsigned int       getHash         (void) const;
+      int                getLocale       (void) const;
+      int                getMonth        (void) const;
+      int                getNiceneDay    (void) const;
+      int                getWeekday      (void) const;
+      int                getYear         (void) const;
+      int                setDate         (int aLocale, int aYear, int aMonth,
+                                            int aDay);
+
+      bool               operator==      (const HistoricDate& date) const;
+      bool               operator!=      (const HistoricDate& date) const;
+      bool               operator<       (const HistoricDate& date) const;
+      bool               operator<=      (const HistoricDate& date) const;
+      bool               operator>       (const HistoricDate& date) const;
+      bool               operator>=      (const HistoricDate& date) const;
+
+      static HistoricDate fromNiceneDay  (int aLocale, int aNiceneDay);
+      static void        getNiceneDays   (const HistoricDate* dates,
+                                            int count, int* output);
+      static int         parse           (const char* text, int aLocale,
+                                            HistoricDate& date);
+
+   private:
+      signed int         nicene      : 27; // the day named
+      unsigned int       gregorian   : 1;  // 1 if in the Gregorian calendar
+      unsigned int       localeIndex : 4;  // or HISTORICDATE_NO_LOCALE
+};
+
+
+
+//////////////////////////////
+//
+// HistoricDate::getNiceneDay -- the day named by the date.
+//
+
+inline int HistoricDate::getNiceneDay(void) const {
+   return nicene;
+}
+
+
+
+//////////////////////////////
+//
+// HistoricDate comparisons -- by the day named, in any calendar.
+//
+
+inline bool HistoricDate::operator==(const HistoricDate& date) const {
+   return nicene == date.nicene;
+}
+
+inline bool HistoricDate::operator!=(const HistoricDate& date) const {
+   return nicene != date.nicene;
+}
+
+inline bool HistoricDate::operator<(const HistoricDate& date) const {
+   return nicene < date.nicene;
+}
+
+inline bool HistoricDate::operator<=(const HistoricDate& date) const {
+   return nicene <= date.nicene;
+}
+
+inline bool HistoricDate::operator>(const HistoricDate& date) const {
+   return nicene > date.nicene;
+}
+
+inline bool HistoricDate::operator>=(const HistoricDate& date) const {
+   return nicene >= date.nicene;
+}
+
+
+// hash<HistoricDate> for unordered containers, by the day named:
+namespace std {
+   template <>
+   struct hash<HistoricDate> {
+      size_t operator()(const HistoricDate& date) const {
+         return date.getHash();
+      }
+   };
+}
+
+
+#endif  // _HISTORICDATE_H_INCLUDED
+
+
+
@@ -0,0 +1,114 @@
+//
+// Creation Date: Mon Oct 19 04:52:40 PDT 2026
+// Last Modified: Mon Oct 19 04:52:40 PDT 2026
+// Filename:      NumberFormat.h
+// Syntax:        C++11
+//
+// Description:   Allocation-free decimal formatting of integers and
+//                dates into a caller's buffer, for the bulk text outputs
+//                (BulkConverter, DateDump, DateJoin, DateQuery and
+//                DateHistogram), which write millions of numbers and
+//                cannot afford snprintf() for each.  Each function
+//                returns a pointer after what it wrote, and does not
+//                write a terminating null.
+//
+
+#ifndef _NUMBERFORMAT_H_INCLUDED
+#define _NUMBERFORMAT_H_INCLUDED
+
+
+//////////////////////////////
+//
+// writeInt -- write a decimal integer and return a pointer after it.
+//     At most 11 characters are written for an int, and 20 for a long
+//     long.
+//
+
+inline char* writeInt(char* p, int value) {
+   char digits[12];
+   int count = 0;
+   unsigned int number = value;
+   if (value < 0) {
+      *p++ = '-';
+      number = 0u - number;
+   }
+   do {
+      digits[count++] = (char)('0' + number % 10);
+      number /= 10;
+   } while (number != 0);
+   while (count > 0) {
+      *p++ = digits[--count];
+   }
+   return p;
+}
+
+inline char* writeInt(char* p, long long value) {
+   char digits[20];
+   int count = 0;
+   unsigned long long number = value;
+   if (value < 0) {
+      *p++ = '-';
+      number = 0ull - number;
+   }
+   do {
+      digits[count++] = (char)('0' + number % 10);
+      number /= 10;
+   } while (number != 0);
+   while (count > 0) {
+      *p++ = digits[--count];
+   }
+   return p;
+}
+
+
+
+//////////////////////////////
+//
+// writePadded -- write a decimal integer with zeros in front of it to
+//     fill width characters (counting a minus sign), as printf("%0*d").
+//     At most 11 characters are written for a width of up to 11.
+//
+
+inline char* writePadded(char* p, int value, int width) {
+   char digits[12];
+   int count = 0;
+   unsigned int number = value;
+   if (value < 0) {
+      *p++ = '-';
+      number = 0u - number;
+      width--;
+   }
+   do {
+      digits[count++] = (char)('0' + number % 10);
+      number /= 10;
+   } while (number != 0);
+   while (count < width) {
+      digits[count++] = '0';
+   }
+   while (count > 0) {
+      *p++ = digits[--count];
+   }
+   return p;
+}
+
+
+
+//////////////////////////////
+//
+// writeDate -- write a date as YYYY-MM-DD, as printf("%04d-%02d-%02d").
+//     At most 17 characters are written.
+//
+
+inline char* writeDate(char* p, int year, int month, int day) {
+   p = writePadded(p, year, 4);
+   *p++ = '-';
+   p = writePadded(p, month, 2);
+   *p++ = '-';
+   return writePadded(p, day, 2);
+}
+
+
+#endif  // _NUMBERFORMAT_H_INCLUDED
+
+
+
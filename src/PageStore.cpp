@@ -0,0 +1,318 @@
+//
+// Creation Date: Sun Oct 18 21:03:26 PDT 2026
+// Last Modified: Sun Oct 18 21:03:26 PDT 2026
+// Filename:      PageStore.cpp
+// Syntax:        C++11
+//
+// Description:   File of pre-rendered month and year pages.  See
+//                PageStore.h for the layout.
+//
+
+#include "ByteOrder.h"
+#include "Calendar.h"
+#include "PageStore.h"
+#include "Trace.h"
+#include "Workers.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// PageStore::PageStore --
+//
+
+PageStore::PageStore(void) {
+   data        = NULL;
+   size        = 0;
+   index       = NULL;
+   firstYear   = 0;
+   lastYear    = -1;
+   threadCount = Workers::getDefaultThreadCount();
+}
+
+
+
+//////////////////////////////
+//
+// PageStore::~PageStore --
+//
+
+PageStore::~PageStore() {
+   if (data != NULL) {
+      munmap((void*)data, size);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// PageStore::build -- render every page and write the store to a file.
+//     Returns the exit status for the program.  At most two chunks of
+//     years per thread are held in memory at once.
+//
+
+int PageStore::build(const string& filename) {
+   FILE* output = fopen(filename.c_str(), "wb");
+   if (output == NULL) {
+      cerr << "Error: cannot write " << filename << ": " << strerror(errno)
+           << endl;
+      return 1;
+   }
+
+   int localeCount = Calendar::getLocaleCount();
+   int i;
+   char header[PAGESTORE_HEADER_SIZE];
+   memset(header, 0, PAGESTORE_HEADER_SIZE);
+   fwrite(header, 1, PAGESTORE_HEADER_SIZE, output);
+   for (i=0; i<localeCount; i++) {
+      char code[4];
+      writeUint32(code, (unsigned int)Calendar::getLocaleByIndex(i));
+      fwrite(code, 1, 4, output);
+   }
+   unsigned long long offset = PAGESTORE_HEADER_SIZE + 4 * localeCount;
+
+   int years = PAGESTORE_LAST_YEAR - PAGESTORE_FIRST_YEAR + 1;
+   size_t chunkCount = (years + PAGESTORE_CHUNK_YEARS - 1) /
+         PAGESTORE_CHUNK_YEARS;
+   vector<string> texts(chunkCount);
+   vector<vector<unsigned int> > entries(chunkCount);
+   string pageIndex;
+   pageIndex.reserve((size_t)years * localeCount * PAGESTORE_PAGES *
+         PAGESTORE_INDEX_ENTRY);
+   int status = 0;
+
+   Workers::runOrdered(threadCount, chunkCount, (size_t)threadCount * 2,
+         "store", [&](size_t k) {
+      int first = PAGESTORE_FIRST_YEAR + (int)k * PAGESTORE_CHUNK_YEARS;
+      int last = first + PAGESTORE_CHUNK_YEARS - 1;
+      if (last > PAGESTORE_LAST_YEAR) {
+         last = PAGESTORE_LAST_YEAR;
+      }
+      TraceSpan span("storeChunk", "chunk", (int)k);
+      renderYears(first, last, texts[k], entries[k]);
+   }, [&](size_t k) {
+      // write the page text of each chunk in order, keeping its index
+      // entries with the offsets made relative to the file:
+      if (offset + texts[k].size() > 0xffffffffULL) {
+         status = 1;
+      }
+      fwrite(texts[k].data(), 1, texts[k].size(), output);
+      char entry[PAGESTORE_INDEX_ENTRY];
+      for (size_t e=0; e+1<entries[k].size(); e+=2) {
+         writeUint32(entry, (unsigned int)(offset + entries[k][e]));
+         writeUint32(entry + 4, entries[k][e+1]);
+         pageIndex.append(entry, PAGESTORE_INDEX_ENTRY);
+      }
+      offset += texts[k].size();
+      string().swap(texts[k]);
+      vector<unsigned int>().swap(entries[k]);
+   });
+
+   if (status != 0) {
+      cerr << "Error: " << filename << " would be larger than 4 GB" << endl;
+      fclose(output);
+      return 1;
+   }
+
+   fwrite(pageIndex.data(), 1, pageIndex.size(), output);
+   memcpy(header, "HCALPGS1", 8);
+   writeUint32(header + 8, 1);
+   writeUint32(header + 12, PAGESTORE_FIRST_YEAR);
+   writeUint32(header + 16, PAGESTORE_LAST_YEAR);
+   writeUint32(header + 20, (unsigned int)localeCount);
+   writeUint32(header + 24, PAGESTORE_PAGES);
+   writeUint64(header + 32, offset);
+   fseek(output, 0, SEEK_SET);
+   fwrite(header, 1, PAGESTORE_HEADER_SIZE, output);
+   if (ferror(output) | fclose(output)) {
+      cerr << "Error: cannot write " << filename << endl;
+      return 1;
+   }
+   return 0;
+}
+
+
+
+//////////////////////////////
+//
+// PageStore::findPage -- find a page of a year in a locale.  Returns
+//     false if the store does not have it.
+//
+
+int PageStore::findPage(int aLocale, int year, int page, const char*& text,
+      int& length) const {
+   if (data == NULL || year < firstYear || year > lastYear || page < 0 ||
+         page >= PAGESTORE_PAGES) {
+      return 0;
+   }
+   int localeIndex = Calendar::getLocaleIndex(aLocale);
+   if (localeIndex < 0) {
+      return 0;
+   }
+   size_t entry = ((size_t)(year - firstYear) * Calendar::getLocaleCount() +
+         localeIndex) * PAGESTORE_PAGES + page;
+   const char* p = index + entry * PAGESTORE_INDEX_ENTRY;
+   unsigned int offset = readUint32(p);
+   unsigned int pageLength = readUint32(p + 4);
+   if ((unsigned long long)offset + pageLength > size) {
+      return 0;
+   }
+   text = data + offset;
+   length = (int)pageLength;
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// PageStore::open -- map a store built by build().  Returns 0 if the
+//     file cannot be read or was built for a different set of locales.
+//
+
+int PageStore::open(const string& filename) {
+   int fd = ::open(filename.c_str(), O_RDONLY);
+   if (fd < 0) {
+      return 0;
+   }
+   struct stat info;
+   if (fstat(fd, &info) != 0 || info.st_size < PAGESTORE_HEADER_SIZE) {
+      close(fd);
+      return 0;
+   }
+   size_t fileSize = info.st_size;
+   void* mapping = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (mapping == MAP_FAILED) {
+      return 0;
+   }
+   const char* p = (const char*)mapping;
+
+   int localeCount = Calendar::getLocaleCount();
+   int first = (int)readUint32(p + 12);
+   int last = (int)readUint32(p + 16);
+   unsigned long long indexOffset = readUint64(p + 32);
+   int valid = memcmp(p, "HCALPGS1", 8) == 0 && readUint32(p + 8) == 1 &&
+         (int)readUint32(p + 20) == localeCount &&
+         readUint32(p + 24) == PAGESTORE_PAGES && first <= last &&
+         fileSize >= PAGESTORE_HEADER_SIZE + 4 * (size_t)localeCount &&
+         indexOffset + (unsigned long long)(last - first + 1) * localeCount *
+         PAGESTORE_PAGES * PAGESTORE_INDEX_ENTRY == fileSize;
+   for (int i=0; valid && i<localeCount; i++) {
+      if ((int)readUint32(p + PAGESTORE_HEADER_SIZE + 4 * i) !=
+            Calendar::getLocaleByIndex(i)) {
+         valid = 0;
+      }
+   }
+   if (!valid) {
+      munmap(mapping, fileSize);
+      return 0;
+   }
+
+   if (data != NULL) {
+      munmap((void*)data, size);
+   }
+   data      = p;
+   size      = fileSize;
+   index     = p + indexOffset;
+   firstYear = first;
+   lastYear  = last;
+   return 1;
+}
+
+
+
+//////////////////////////////
+//
+// PageStore::setThreadCount -- set the number of worker threads, or the
+//     number of hardware threads if count is less than 1.
+//
+
+void PageStore::setThreadCount(int count) {
+   if (count < 1) {
+      threadCount = Workers::getDefaultThreadCount();
+   } else {
+      threadCount = count;
+   }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// PageStore::renderYears -- render the pages of the years startYear to
+//     endYear into text, appending an offset (within text) and length to
+//     entries for each page in index order.  A page which is the same as
+//     the page of an earlier locale in the same year is not repeated.
+//
+
+void PageStore::renderYears(int startYear, int endYear, string& text,
+      vector<unsigned int>& entries) {
+   int localeCount = Calendar::getLocaleCount();
+   vector<unsigned int> yearEntries((size_t)localeCount * PAGESTORE_PAGES * 2);
+   char buffer[CALENDAR_MONTH_SIZE];
+   stringstream out;
+   Calendar cal;
+
+   for (int year=startYear; year<=endYear; year++) {
+      for (int page=0; page<PAGESTORE_PAGES; page++) {
+         for (int i=0; i<localeCount; i++) {
+            int aLocale = Calendar::getLocaleByIndex(i);
+            const char* pageText;
+            int length;
+            string yearText;
+            if (page < 12) {
+               cal.setDate(year, page + 1, 1, aLocale);
+               length = cal.renderMonth(buffer, CALENDAR_MONTH_SIZE);
+               pageText = buffer;
+            } else {
+               cal.setDate(year, 1, 1, aLocale);
+               out.str("");
+               cal.printYear(out, page == PAGESTORE_SINGLE_PAGE ? 1 : 0);
+               yearText = out.str();
+               pageText = yearText.data();
+               length = (int)yearText.size();
+            }
+
+            // look for the same page in an earlier locale:
+            unsigned int* entry = &yearEntries[(i * PAGESTORE_PAGES +
+                  page) * 2];
+            int j;
+            for (j=0; j<i; j++) {
+               unsigned int* other = &yearEntries[(j * PAGESTORE_PAGES +
+                     page) * 2];
+               if (other[1] == (unsigned int)length && memcmp(text.data() +
+                     other[0], pageText, length) == 0) {
+                  entry[0] = other[0];
+                  entry[1] = other[1];
+                  break;
+               }
+            }
+            if (j == i) {
+               entry[0] = (unsigned int)text.size();
+               entry[1] = (unsigned int)length;
+               text.append(pageText, length);
+            }
+         }
+      }
+      entries.insert(entries.end(), yearEntries.begin(), yearEntries.end());
+   }
+}
+
+
+
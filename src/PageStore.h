@@ -0,0 +1,91 @@
+//
+// Creation Date: Sun Oct 18 21:03:26 PDT 2026
+// Last Modified: Sun Oct 18 21:03:26 PDT 2026
+// Filename:      PageStore.h
+// Syntax:        C++11
+//
+// Description:   File of pre-rendered month and year pages (--build-store)
+//                which is memory-mapped and served from instead of
+//                rendering (--store or the HCAL_STORE environment
+//                variable).  A page is found with one index lookup.
+//
+// The store holds, for each year from PAGESTORE_FIRST_YEAR to
+// PAGESTORE_LAST_YEAR and each locale of Calendar::getLocaleByIndex(),
+// PAGESTORE_PAGES pages: the twelve months as written by printMonth()
+// and the year as written by printYear() in both layouts.  Pages which
+// are identical in several locales of the same year are stored once.
+//
+// All integers are little-endian.  The file is laid out as:
+//    header (PAGESTORE_HEADER_SIZE bytes):
+//       offset  0  char[8]  "HCALPGS1"
+//       offset  8  uint32   version (1)
+//       offset 12  uint32   first year
+//       offset 16  uint32   last year
+//       offset 20  uint32   number of locales
+//       offset 24  uint32   pages per year and locale (PAGESTORE_PAGES)
+//       offset 28  uint32   zero
+//       offset 32  uint64   file offset of the index
+//    locale codes, one int32 for each locale
+//    page text
+//    index, one 8-byte entry for each page, ordered by year, locale
+//    and page:
+//       offset  0  uint32   file offset of the page text
+//       offset  4  uint32   length of the page text
+//
+
+#ifndef _PAGESTORE_H_INCLUDED
+#define _PAGESTORE_H_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Years included in the store:
+#define PAGESTORE_FIRST_YEAR     1
+#define PAGESTORE_LAST_YEAR      9999
+
+// Pages of each year and locale (0-11 are the months):
+#define PAGESTORE_YEAR_PAGE      12   /* printYear() in three columns */
+#define PAGESTORE_SINGLE_PAGE    13   /* printYear() in one column    */
+#define PAGESTORE_PAGES          14
+
+// Sizes of the fixed parts of the format:
+#define PAGESTORE_HEADER_SIZE    40
+#define PAGESTORE_INDEX_ENTRY    8
+
+// Number of years rendered by a worker thread at a time:
+#define PAGESTORE_CHUNK_YEARS    50
+
+
+class PageStore {
+   public:
+                         PageStore       (void);
+                        ~PageStore       ();
+
+      int                build           (const string& filename);
+      int                findPage        (int aLocale, int year, int page,
+                                            const char*& text,
+                                            int& length) const;
+      int                open            (const string& filename);
+      void               setThreadCount  (int count);
+
+   private:
+      const char*        data;           // memory-mapped file
+      size_t             size;           // size of the file
+      const char*        index;          // start of the index
+      int                firstYear;      // first year in the store
+      int                lastYear;       // last year in the store
+      int                threadCount;    // number of worker threads
+
+      static void        renderYears     (int startYear, int endYear,
+                                            string& text,
+                                            vector<unsigned int>& entries);
+};
+
+
+#endif  // _PAGESTORE_H_INCLUDED
+
+
+
@@ -0,0 +1,236 @@
+//
+// Creation Date: Sun Oct 18 12:20:31 PDT 2026
+// Last Modified: Sun Oct 18 12:20:31 PDT 2026
+// Filename:      PerfCounters.cpp
+// Syntax:        C++11
+//
+// Description:   Hardware performance counters read with perf_event_open
+//                on Linux.
+//
+
+#include "PerfCounters.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+   #include <linux/perf_event.h>
+   #include <sys/ioctl.h>
+   #include <sys/syscall.h>
+   #include <unistd.h>
+#endif
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// PerfCounters::PerfCounters --
+//
+
+PerfCounters::PerfCounters(void) {
+   for (int i=0; i<PERF_COUNTER_COUNT; i++) {
+      fd[i] = -1;
+      value[i] = 0;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// PerfCounters::~PerfCounters --
+//
+
+PerfCounters::~PerfCounters() {
+   close();
+}
+
+
+
+//////////////////////////////
+//
+// PerfCounters::open -- open the counters for the calling thread.  Returns
+//     the number of counters which could be opened.  If none could be
+//     opened, getError() gives the reason.
+//
+
+int PerfCounters::open(void) {
+   close();
+   error.clear();
+#ifdef __linux__
+   static const unsigned int types[PERF_COUNTER_COUNT] = {
+      PERF_TYPE_HARDWARE,
+      PERF_TYPE_HARDWARE,
+      PERF_TYPE_HARDWARE,
+      PERF_TYPE_HW_CACHE
+   };
+   static const unsigned long long configs[PERF_COUNTER_COUNT] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_BRANCH_MISSES,
+      PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+   };
+
+   int count = 0;
+   for (int i=0; i<PERF_COUNTER_COUNT; i++) {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size           = sizeof(attr);
+      attr.type           = types[i];
+      attr.config         = configs[i];
+      attr.disabled       = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      fd[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+      if (fd[i] < 0) {
+         if (error.empty()) {
+            error = strerror(errno);
+         }
+         fd[i] = -1;
+      } else {
+         count++;
+      }
+   }
+   if (count > 0) {
+      error.clear();
+   }
+   return count;
+#else
+   error = "perf_event_open is only available on Linux";
+   return 0;
+#endif
+}
+
+
+
+//////////////////////////////
+//
+// PerfCounters::close -- release the counters.
+//
+
+void PerfCounters::close(void) {
+   for (int i=0; i<PERF_COUNTER_COUNT; i++) {
+#ifdef __linux__
+      if (fd[i] >= 0) {
+         ::close(fd[i]);
+      }
+#endif
+      fd[i] = -1;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// PerfCounters::isAvailable -- returns true if the counter is open.
+//
+
+int PerfCounters::isAvailable(int counter) const {
+   return fd[counter] >= 0;
+}
+
+
+
+//////////////////////////////
+//
+// PerfCounters::anyAvailable -- returns true if any counter is open.
+//
+
+int PerfCounters::anyAvailable(void) const {
+   for (int i=0; i<PERF_COUNTER_COUNT; i++) {
+      if (fd[i] >= 0) {
+         return 1;
+      }
+   }
+   return 0;
+}
+
+
+
+//////////////////////////////
+//
+// PerfCounters::getError -- reason why the counters could not be opened.
+//
+
+const string& PerfCounters::getError(void) const {
+   return error;
+}
+
+
+
+//////////////////////////////
+//
+// PerfCounters::getValue -- counter value between the last start()
+//     and stop() calls.
+//
+
+long long PerfCounters::getValue(int counter) const {
+   return value[counter];
+}
+
+
+
+//////////////////////////////
+//
+// PerfCounters::start -- reset and enable the open counters.
+//
+
+void PerfCounters::start(void) {
+   for (int i=0; i<PERF_COUNTER_COUNT; i++) {
+      value[i] = 0;
+#ifdef __linux__
+      if (fd[i] >= 0) {
+         ioctl(fd[i], PERF_EVENT_IOC_RESET, 0);
+         ioctl(fd[i], PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+   }
+}
+
+
+
+//////////////////////////////
+//
+// PerfCounters::stop -- disable the open counters and read their values.
+//
+
+void PerfCounters::stop(void) {
+#ifdef __linux__
+   int i;
+   for (i=0; i<PERF_COUNTER_COUNT; i++) {
+      if (fd[i] >= 0) {
+         ioctl(fd[i], PERF_EVENT_IOC_DISABLE, 0);
+      }
+   }
+   for (i=0; i<PERF_COUNTER_COUNT; i++) {
+      if (fd[i] >= 0) {
+         long long count = 0;
+         if (read(fd[i], &count, sizeof(count)) == sizeof(count)) {
+            value[i] = count;
+         }
+      }
+   }
+#endif
+}
+
+
+
+//////////////////////////////
+//
+// PerfCounters::getName -- short name of the counter.
+//
+
+const char* PerfCounters::getName(int counter) {
+   switch (counter) {
+      case PERF_CYCLES:        return "cycles";
+      case PERF_INSTRUCTIONS:  return "instructions";
+      case PERF_BRANCH_MISSES: return "branch-misses";
+      case PERF_L1D_MISSES:    return "L1-dcache-misses";
+      default:                 return "unknown";
+   }
+}
+
+
+
@@ -0,0 +1,53 @@
+//
+// Creation Date: Sun Oct 18 12:20:31 PDT 2026
+// Last Modified: Sun Oct 18 12:20:31 PDT 2026
+// Filename:      PerfCounters.h
+// Syntax:        C++11
+//
+// Description:   Hardware performance counters read with perf_event_open
+//                on Linux.  Counters which cannot be opened (no kernel
+//                support, or not permitted by perf_event_paranoid) are
+//                marked as unavailable rather than causing an error.
+//
+
+#ifndef _PERFCOUNTERS_H_INCLUDED
+#define _PERFCOUNTERS_H_INCLUDED
+
+#include <string>
+
+using namespace std;
+
+#define PERF_CYCLES           0
+#define PERF_INSTRUCTIONS     1
+#define PERF_BRANCH_MISSES    2
+#define PERF_L1D_MISSES       3
+#define PERF_COUNTER_COUNT    4
+
+
+class PerfCounters {
+   public:
+                         PerfCounters    (void);
+                        ~PerfCounters    ();
+
+      int                open            (void);
+      void               close           (void);
+      int                isAvailable     (int counter) const;
+      int                anyAvailable    (void) const;
+      const string&      getError        (void) const;
+      long long          getValue        (int counter) const;
+      void               start           (void);
+      void               stop            (void);
+
+      static const char* getName         (int counter);
+
+   private:
+      int                fd[PERF_COUNTER_COUNT];
+      long long          value[PERF_COUNTER_COUNT];
+      string             error;
+};
+
+
+#endif  // _PERFCOUNTERS_H_INCLUDED
+
+
+
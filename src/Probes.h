@@ -0,0 +1,53 @@
+//
+// Creation Date: Sun Oct 18 14:18:09 PDT 2026
+// Last Modified: Sun Oct 18 14:18:09 PDT 2026
+// Filename:      Probes.h
+// Syntax:        C++11
+//
+// Description:   USDT static tracepoints (provider "hcal") for attaching
+//                bpftrace or perf to a running hcal.  Enabled by building
+//                with HCAL_USDT defined (make usdt), which requires
+//                <sys/sdt.h> from systemtap.  Each probe is a single nop
+//                when no tracer is attached, and the macros expand to
+//                nothing when HCAL_USDT is not defined.
+//
+// Probes:
+//    niceneday__entry(calendar, year, month, day)
+//    niceneday__return(niceneDay)
+//    inverse__entry(locale, niceneDay)       (Calendar::getDate)
+//    inverse__return(year)
+//    calendar__resolve(locale, niceneDay, calendar)
+//    render__month__start(year, month, style)
+//    render__month__end(length)
+//    render__year__start(year, style)
+//    render__year__end()
+//    batch__record__start(record)
+//    batch__record__end(record)
+//
+// Example:
+//    bpftrace -e 'usdt:./hcal:hcal:render__month__start { @[arg1] = count(); }'
+//
+
+#ifndef _PROBES_H_INCLUDED
+#define _PROBES_H_INCLUDED
+
+#ifdef HCAL_USDT
+   #include <sys/sdt.h>
+   #define HCAL_PROBE0(name)              DTRACE_PROBE(hcal, name)
+   #define HCAL_PROBE1(name, a)           DTRACE_PROBE1(hcal, name, a)
+   #define HCAL_PROBE2(name, a, b)        DTRACE_PROBE2(hcal, name, a, b)
+   #define HCAL_PROBE3(name, a, b, c)     DTRACE_PROBE3(hcal, name, a, b, c)
+   #define HCAL_PROBE4(name, a, b, c, d)  DTRACE_PROBE4(hcal, name, a, b, c, d)
+#else
+   #define HCAL_PROBE0(name)
+   #define HCAL_PROBE1(name, a)
+   #define HCAL_PROBE2(name, a, b)
+   #define HCAL_PROBE3(name, a, b, c)
+   #define HCAL_PROBE4(name, a, b, c, d)
+#endif
+
+
+#endif  // _PROBES_H_INCLUDED
+
+
+
@@ -0,0 +1,126 @@
+//
+// Creation Date: Sun Oct 18 10:12:40 PDT 2026
+// Last Modified: Sun Oct 18 20:14:51 PDT 2026
+// Filename:      Stats.cpp
+// Syntax:        C++11
+//
+// Description:   Per-phase timing and call counters for hcal (--stats).
+//
+
+#include "Stats.h"
+#include <iomanip>
+
+using namespace std;
+
+// declaration of static variables:
+int Stats::enabled = 0;
+atomic<unsigned long long> Stats::counters[STATS_COUNT_COUNT];
+chrono::steady_clock::time_point Stats::phaseStart[STATS_PHASE_COUNT];
+chrono::steady_clock::duration Stats::phaseTime[STATS_PHASE_COUNT];
+
+static const char* phaseName[STATS_PHASE_COUNT] = {
+   "options",
+   "locale",
+   "calendar",
+   "render",
+   "output"
+};
+
+
+//////////////////////////////
+//
+// Stats::enable -- start collecting counters.  Phase times are always
+//     collected since the options phase has to be timed before it is
+//     known whether --stats was given.
+//
+
+void Stats::enable(void) {
+   enabled = 1;
+}
+
+
+
+//////////////////////////////
+//
+// Stats::recordWrite -- count one write call of the given number of bytes.
+//
+
+void Stats::recordWrite(unsigned long long bytes) {
+   count(STATS_COUNT_WRITEBYTES, bytes);
+   count(STATS_COUNT_WRITECALLS);
+}
+
+
+
+//////////////////////////////
+//
+// Stats::startPhase -- mark the start of a timed phase.
+//
+
+void Stats::startPhase(int phase) {
+   phaseStart[phase] = chrono::steady_clock::now();
+}
+
+
+
+//////////////////////////////
+//
+// Stats::stopPhase -- add the time since startPhase() to the phase total.
+//     A phase may be started and stopped more than once.
+//
+
+void Stats::stopPhase(int phase) {
+   phaseTime[phase] += chrono::steady_clock::now() - phaseStart[phase];
+}
+
+
+
+//////////////////////////////
+//
+// Stats::print -- print the phase times (in milliseconds) and the
+//     counters.  default value: out = cerr
+//
+
+ostream& Stats::print(ostream& out) {
+   double total = 0.0;
+   double ms;
+   int i;
+
+   out << "hcal statistics:\n";
+   out << fixed << setprecision(3);
+   for (i=0; i<STATS_PHASE_COUNT; i++) {
+      ms = chrono::duration<double, milli>(phaseTime[i]).count();
+      total += ms;
+      out << "   " << left << setw(20) << phaseName[i]
+          << right << setw(12) << ms << " ms\n";
+   }
+   out << "   " << left << setw(20) << "total"
+       << right << setw(12) << total << " ms\n";
+
+   out << "   " << left << setw(20) << "niceneDay calls"
+       << right << setw(12) << counters[STATS_COUNT_NICENEDAY].load() << '\n';
+   out << "   " << left << setw(20) << "getDay calls"
+       << right << setw(12) << counters[STATS_COUNT_GETDAY].load() << '\n';
+   out << "   " << left << setw(20) << "getCalendar calls"
+       << right << setw(12) << counters[STATS_COUNT_GETCALENDAR].load() << '\n';
+   out << "   " << left << setw(20) << "stepped dates"
+       << right << setw(12) << counters[STATS_COUNT_STEPPED].load() << '\n';
+   out << "   " << left << setw(20) << "convert cache hits"
+       << right << setw(12) << counters[STATS_COUNT_CONVERTHIT].load() << '\n';
+   out << "   " << left << setw(20) << "convert cache misses"
+       << right << setw(12) << counters[STATS_COUNT_CONVERTMISS].load() << '\n';
+   out << "   " << left << setw(20) << "render cache hits"
+       << right << setw(12) << counters[STATS_COUNT_RENDERHIT].load() << '\n';
+   out << "   " << left << setw(20) << "render cache misses"
+       << right << setw(12) << counters[STATS_COUNT_RENDERMISS].load() << '\n';
+   out << "   " << left << setw(20) << "bytes written"
+       << right << setw(12) << counters[STATS_COUNT_WRITEBYTES].load() << '\n';
+   out << "   " << left << setw(20) << "write calls"
+       << right << setw(12) << counters[STATS_COUNT_WRITECALLS].load() << '\n';
+   out << flush;
+
+   return out;
+}
+
+
+
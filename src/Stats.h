@@ -0,0 +1,90 @@
+//
+// Creation Date: Sun Oct 18 10:12:40 PDT 2026
+// Last Modified: Sun Oct 18 20:14:51 PDT 2026
+// Filename:      Stats.h
+// Syntax:        C++11
+//
+// Description:   Per-phase timing and call counters for hcal (--stats).
+//                Counters only cost a test of the enabled flag when
+//                statistics have not been requested.
+//
+
+#ifndef _STATS_H_INCLUDED
+#define _STATS_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+// Program phases which are timed:
+#define STATS_PHASE_OPTIONS         0
+#define STATS_PHASE_LOCALE          1
+#define STATS_PHASE_CALENDAR        2
+#define STATS_PHASE_RENDER          3
+#define STATS_PHASE_OUTPUT          4
+#define STATS_PHASE_COUNT           5
+
+// Event counters:
+#define STATS_COUNT_NICENEDAY       0
+#define STATS_COUNT_GETDAY          1
+#define STATS_COUNT_GETCALENDAR     2
+#define STATS_COUNT_WRITEBYTES      3
+#define STATS_COUNT_WRITECALLS      4
+#define STATS_COUNT_STEPPED         5
+#define STATS_COUNT_CONVERTHIT      6
+#define STATS_COUNT_CONVERTMISS     7
+#define STATS_COUNT_RENDERHIT       8
+#define STATS_COUNT_RENDERMISS      9
+#define STATS_COUNT_COUNT          10
+
+
+class Stats {
+   public:
+      static void        enable          (void);
+      static int         isEnabled       (void);
+      static void        count           (int counter,
+                                            unsigned long long amount = 1);
+      static void        recordWrite     (unsigned long long bytes);
+      static void        startPhase      (int phase);
+      static void        stopPhase       (int phase);
+      static ostream&    print           (ostream& out = cerr);
+
+   private:
+      static int                                 enabled;
+      static atomic<unsigned long long>          counters[STATS_COUNT_COUNT];
+      static chrono::steady_clock::time_point    phaseStart[STATS_PHASE_COUNT];
+      static chrono::steady_clock::duration      phaseTime[STATS_PHASE_COUNT];
+};
+
+
+
+//////////////////////////////
+//
+// Stats::isEnabled -- returns true if --stats was given.
+//
+
+inline int Stats::isEnabled(void) {
+   return enabled;
+}
+
+
+
+//////////////////////////////
+//
+// Stats::count -- increment a counter.  Does nothing unless statistics
+//     are enabled.  default value: amount = 1
+//
+
+inline void Stats::count(int counter, unsigned long long amount) {
+   if (enabled) {
+      counters[counter].fetch_add(amount, memory_order_relaxed);
+   }
+}
+
+
+#endif  // _STATS_H_INCLUDED
+
+
+
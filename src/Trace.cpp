@@ -0,0 +1,197 @@
+//
+// Creation Date: Sun Oct 18 11:02:15 PDT 2026
+// Last Modified: Sun Oct 18 11:02:15 PDT 2026
+// Filename:      Trace.cpp
+// Syntax:        C++11
+//
+// Description:   Chrome/Perfetto trace-event output for hcal (--trace).
+//
+
+#include "Trace.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace std;
+
+
+// TraceBuffer -- per-thread ring of events.  Only the owning thread
+//    writes into the ring; the buffers are linked into a list (with a
+//    compare-and-swap) so that they can be found at exit.
+
+class TraceBuffer {
+   public:
+      TraceEvent         events[TRACE_RING_SIZE];
+      atomic<unsigned long long> count;  // number of events recorded
+      int                tid;            // thread number for the trace
+      const char*        threadName;     // static string or NULL
+      TraceBuffer*       next;
+};
+
+// declaration of static variables:
+int    Trace::enabled  = 0;
+string Trace::filename;
+
+static atomic<TraceBuffer*> bufferList(NULL);
+static atomic<int> threadCount(0);
+static thread_local TraceBuffer* threadBuffer = NULL;
+static const chrono::steady_clock::time_point startTime =
+      chrono::steady_clock::now();
+
+static TraceBuffer* getThreadBuffer (void);
+
+
+//////////////////////////////
+//
+// Trace::enable -- start recording events, which will be written to
+//     the given file when the program exits.
+//
+
+void Trace::enable(const string& aFilename) {
+   if (enabled) {
+      return;
+   }
+   filename = aFilename;
+   enabled = 1;
+   setThreadName("main");
+   atexit(Trace::write);
+}
+
+
+
+//////////////////////////////
+//
+// Trace::now -- nanoseconds since the start of the program.
+//
+
+long long Trace::now(void) {
+   return chrono::duration_cast<chrono::nanoseconds>(
+         chrono::steady_clock::now() - startTime).count();
+}
+
+
+
+//////////////////////////////
+//
+// Trace::record -- store a completed span in the ring buffer of the
+//     calling thread.
+//     default values: argName = NULL, argValue = 0
+//
+
+void Trace::record(const char* name, long long start, long long duration,
+      const char* argName, int argValue) {
+   if (!enabled) {
+      return;
+   }
+   TraceBuffer* buffer = getThreadBuffer();
+   unsigned long long index = buffer->count.load(memory_order_relaxed);
+   TraceEvent& event = buffer->events[index % TRACE_RING_SIZE];
+   event.name     = name;
+   event.argName  = argName;
+   event.argValue = argValue;
+   event.start    = start;
+   event.duration = duration;
+   buffer->count.store(index + 1, memory_order_release);
+}
+
+
+
+//////////////////////////////
+//
+// Trace::setThreadName -- label the calling thread in the trace viewer.
+//     The name must be a static string.
+//
+
+void Trace::setThreadName(const char* name) {
+   if (!enabled) {
+      return;
+   }
+   getThreadBuffer()->threadName = name;
+}
+
+
+
+//////////////////////////////
+//
+// Trace::write -- write all recorded events as trace-event JSON.  This
+//     is called at exit, after any worker threads have been joined.
+//
+
+void Trace::write(void) {
+   if (!enabled) {
+      return;
+   }
+   FILE* output = fopen(filename.c_str(), "w");
+   if (output == NULL) {
+      fprintf(stderr, "Error: cannot write trace file %s\n",
+            filename.c_str());
+      return;
+   }
+
+   int pid = (int)getpid();
+   int comma = 0;
+   fprintf(output, "{\"traceEvents\":[\n");
+   TraceBuffer* buffer = bufferList.load(memory_order_acquire);
+   while (buffer != NULL) {
+      if (buffer->threadName != NULL) {
+         fprintf(output, "%s{\"name\":\"thread_name\",\"ph\":\"M\","
+               "\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+               comma ? ",\n" : "", pid, buffer->tid, buffer->threadName);
+         comma = 1;
+      }
+      unsigned long long count = buffer->count.load(memory_order_acquire);
+      unsigned long long first = 0;
+      if (count > TRACE_RING_SIZE) {
+         first = count - TRACE_RING_SIZE;
+      }
+      for (unsigned long long i=first; i<count; i++) {
+         TraceEvent& event = buffer->events[i % TRACE_RING_SIZE];
+         fprintf(output, "%s{\"name\":\"%s\",\"cat\":\"hcal\",\"ph\":\"X\","
+               "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d",
+               comma ? ",\n" : "", event.name, event.start / 1000.0,
+               event.duration / 1000.0, pid, buffer->tid);
+         if (event.argName != NULL) {
+            fprintf(output, ",\"args\":{\"%s\":%d}", event.argName,
+                  event.argValue);
+         }
+         fprintf(output, "}");
+         comma = 1;
+      }
+      buffer = buffer->next;
+   }
+   fprintf(output, "\n],\"displayTimeUnit\":\"ms\"}\n");
+   fclose(output);
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// getThreadBuffer -- return the ring buffer of the calling thread,
+//     creating it on first use.
+//
+
+static TraceBuffer* getThreadBuffer(void) {
+   if (threadBuffer != NULL) {
+      return threadBuffer;
+   }
+   TraceBuffer* buffer = new TraceBuffer;
+   buffer->count.store(0);
+   buffer->tid = ++threadCount;
+   buffer->threadName = NULL;
+   buffer->next = bufferList.load(memory_order_relaxed);
+   while (!bufferList.compare_exchange_weak(buffer->next, buffer,
+         memory_order_release, memory_order_relaxed)) {
+      // retry with updated list head
+   }
+   threadBuffer = buffer;
+   return buffer;
+}
+
+
+
@@ -0,0 +1,118 @@
+//
+// Creation Date: Sun Oct 18 11:02:15 PDT 2026
+// Last Modified: Sun Oct 18 11:02:15 PDT 2026
+// Filename:      Trace.h
+// Syntax:        C++11
+//
+// Description:   Chrome/Perfetto trace-event output for hcal (--trace).
+//                Spans are stored in a fixed-size ring buffer owned by
+//                each thread, so recording an event needs no locks.
+//                The buffers are written as JSON when the program exits.
+//
+
+#ifndef _TRACE_H_INCLUDED
+#define _TRACE_H_INCLUDED
+
+#include <atomic>
+#include <string>
+
+using namespace std;
+
+// Number of events kept per thread (older events are overwritten):
+#define TRACE_RING_SIZE  65536
+
+
+class TraceEvent {
+   public:
+      const char*        name;           // span name (static string)
+      const char*        argName;        // optional argument name or NULL
+      int                argValue;       // value of the argument
+      long long          start;          // nanoseconds since program start
+      long long          duration;       // nanoseconds
+};
+
+
+class Trace {
+   public:
+      static void        enable          (const string& filename);
+      static int         isEnabled       (void);
+      static long long   now             (void);
+      static void        record          (const char* name, long long start,
+                                            long long duration,
+                                            const char* argName = NULL,
+                                            int argValue = 0);
+      static void        setThreadName   (const char* name);
+      static void        write           (void);
+
+   private:
+      static int         enabled;
+      static string      filename;
+};
+
+
+
+// TraceSpan -- records the lifetime of the object as a span.  Nothing
+//     is done if tracing is not enabled.
+
+class TraceSpan {
+   public:
+                         TraceSpan       (const char* aName,
+                                            const char* anArgName = NULL,
+                                            int anArgValue = 0);
+                        ~TraceSpan       ();
+
+   private:
+      const char*        name;
+      const char*        argName;
+      int                argValue;
+      long long          start;
+};
+
+
+
+//////////////////////////////
+//
+// Trace::isEnabled -- returns true if --trace was given.
+//
+
+inline int Trace::isEnabled(void) {
+   return enabled;
+}
+
+
+
+//////////////////////////////
+//
+// TraceSpan::TraceSpan -- default values: anArgName = NULL, anArgValue = 0
+//
+
+inline TraceSpan::TraceSpan(const char* aName, const char* anArgName,
+      int anArgValue) {
+   if (Trace::isEnabled()) {
+      name     = aName;
+      argName  = anArgName;
+      argValue = anArgValue;
+      start    = Trace::now();
+   } else {
+      name = NULL;
+   }
+}
+
+
+
+//////////////////////////////
+//
+// TraceSpan::~TraceSpan --
+//
+
+inline TraceSpan::~TraceSpan() {
+   if (name != NULL) {
+      Trace::record(name, start, Trace::now() - start, argName, argValue);
+   }
+}
+
+
+#endif  // _TRACE_H_INCLUDED
+
+
+
@@ -0,0 +1,142 @@
+//
+// Creation Date: Mon Oct 19 04:20:15 PDT 2026
+// Last Modified: Mon Oct 19 04:20:15 PDT 2026
+// Filename:      Workers.cpp
+// Syntax:        C++11
+//
+// Description:   Worker threads shared by the bulk commands.  See
+//                Workers.h.
+//
+
+#include "Trace.h"
+#include "Workers.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// Workers::getDefaultThreadCount -- the number of hardware threads.
+//
+
+int Workers::getDefaultThreadCount(void) {
+   int count = (int)thread::hardware_concurrency();
+   if (count < 1) {
+      count = 1;
+   }
+   return count;
+}
+
+
+
+//////////////////////////////
+//
+// Workers::run -- call work(t) for t from 0 to threadCount - 1, each in
+//     its own thread, and wait for them.  A single worker runs in the
+//     calling thread.  The threads are labelled threadName in traces.
+//     default value: threadName = NULL
+//
+
+void Workers::run(int threadCount, const function<void(int)>& work,
+      const char* threadName) {
+   if (threadCount <= 1) {
+      work(0);
+      return;
+   }
+   vector<thread> workers;
+   for (int t=0; t<threadCount; t++) {
+      workers.push_back(thread([&work, threadName](int index) {
+         if (threadName != NULL) {
+            Trace::setThreadName(threadName);
+         }
+         work(index);
+      }, t));
+   }
+   for (size_t t=0; t<workers.size(); t++) {
+      workers[t].join();
+   }
+}
+
+
+
+//////////////////////////////
+//
+// Workers::runOrdered -- call make(k) for every chunk k from 0 to
+//     chunkCount - 1 in up to threadCount worker threads, and write(k) in
+//     the calling thread for each chunk in order once make(k) has
+//     finished.  A worker only starts chunk k when k < w + window, where w
+//     chunks have been written, so at most window chunks are made but
+//     not yet written.
+//
+
+void Workers::runOrdered(int threadCount, size_t chunkCount, size_t window,
+      const char* threadName, const function<void(size_t)>& make,
+      const function<void(size_t)>& write) {
+   if (window < 1) {
+      window = 1;
+   }
+   vector<char> done(chunkCount, 0);
+   size_t next = 0;
+   size_t written = 0;
+   mutex lock;
+   condition_variable ready;
+
+   auto worker = [&]() {
+      Trace::setThreadName(threadName);
+      while (1) {
+         size_t k;
+         {
+            unique_lock<mutex> guard(lock);
+            ready.wait(guard, [&]() {
+               return next >= chunkCount || next < written + window;
+            });
+            if (next >= chunkCount) {
+               return;
+            }
+            k = next++;
+         }
+         make(k);
+         {
+            lock_guard<mutex> guard(lock);
+            done[k] = 1;
+         }
+         ready.notify_all();
+      }
+   };
+
+   int workerCount = threadCount;
+   if ((size_t)workerCount > chunkCount) {
+      workerCount = (int)chunkCount;
+   }
+   if (workerCount < 1 && chunkCount > 0) {
+      workerCount = 1;
+   }
+   vector<thread> workers;
+   for (int i=0; i<workerCount; i++) {
+      workers.push_back(thread(worker));
+   }
+
+   for (size_t k=0; k<chunkCount; k++) {
+      {
+         unique_lock<mutex> guard(lock);
+         ready.wait(guard, [&]() { return done[k] != 0; });
+      }
+      write(k);
+      {
+         lock_guard<mutex> guard(lock);
+         written = k + 1;
+      }
+      ready.notify_all();
+   }
+
+   for (size_t i=0; i<workers.size(); i++) {
+      workers[i].join();
+   }
+}
+
+
+
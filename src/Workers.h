@@ -0,0 +1,45 @@
+//
+// Creation Date: Mon Oct 19 04:20:15 PDT 2026
+// Last Modified: Mon Oct 19 04:20:15 PDT 2026
+// Filename:      Workers.h
+// Syntax:        C++11
+//
+// Description:   Worker threads shared by the bulk commands.  run() calls
+//                a function once in each of a number of threads and
+//                waits for them.  runOrdered() makes numbered chunks of
+//                output in worker threads, in any order, and hands them
+//                to a writer in the calling thread in chunk order as soon
+//                as each is finished.  Workers do not start a chunk more
+//                than window chunks ahead of the writer, which bounds the
+//                memory held by finished chunks waiting to be written.
+//
+
+#ifndef _WORKERS_H_INCLUDED
+#define _WORKERS_H_INCLUDED
+
+#include <cstddef>
+#include <functional>
+
+using namespace std;
+
+
+class Workers {
+   public:
+      static int         getDefaultThreadCount(void);
+      static void        run             (int threadCount,
+                                            const function<void(int)>& work,
+                                            const char* threadName = NULL);
+      static void        runOrdered      (int threadCount, size_t chunkCount,
+                                            size_t window,
+                                            const char* threadName,
+                                            const function<void(size_t)>&
+                                               make,
+                                            const function<void(size_t)>&
+                                               write);
+};
+
+
+#endif  // _WORKERS_H_INCLUDED
+
+
+
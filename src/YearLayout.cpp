@@ -0,0 +1,184 @@
+//
+// Creation Date: Mon Oct 19 00:12:48 PDT 2026
+// Last Modified: Mon Oct 19 00:12:48 PDT 2026
+// Filename:      YearLayout.cpp
+// Syntax:        C++11
+//
+// Description:   Index of the layouts of years in every locale.  See
+//                YearLayout.h.
+//
+
+#include "Calendar.h"
+#include "YearLayout.h"
+
+using namespace std;
+
+#define YEARLAYOUT_YEARS   (YEARLAYOUT_LAST_YEAR - YEARLAYOUT_FIRST_YEAR + 1)
+
+static const char* layoutNames[YEARLAYOUT_REFORM] = {
+   "common year starting on Sunday",
+   "common year starting on Monday",
+   "common year starting on Tuesday",
+   "common year starting on Wednesday",
+   "common year starting on Thursday",
+   "common year starting on Friday",
+   "common year starting on Saturday",
+   "leap year starting on Sunday",
+   "leap year starting on Monday",
+   "leap year starting on Tuesday",
+   "leap year starting on Wednesday",
+   "leap year starting on Thursday",
+   "leap year starting on Friday",
+   "leap year starting on Saturday"
+};
+
+
+//////////////////////////////
+//
+// YearLayout::YearLayout --
+//
+
+YearLayout::YearLayout(void) { }
+
+
+
+//////////////////////////////
+//
+// YearLayout::~YearLayout --
+//
+
+YearLayout::~YearLayout() { }
+
+
+
+//////////////////////////////
+//
+// YearLayout::build -- find the layout of every year of every locale, and
+//     sort the years of each locale by layout with a counting sort.
+//
+
+void YearLayout::build(void) {
+   layouts.resize((size_t)LOCALE_COUNT * YEARLAYOUT_YEARS);
+   years.resize((size_t)LOCALE_COUNT * YEARLAYOUT_YEARS);
+   starts.assign((size_t)LOCALE_COUNT * (YEARLAYOUT_COUNT + 1), 0);
+   for (int index=0; index<LOCALE_COUNT; index++) {
+      int aLocale = Calendar::getLocaleByIndex(index);
+      unsigned char* layout = &layouts[(size_t)index * YEARLAYOUT_YEARS];
+      int* start = &starts[(size_t)index * (YEARLAYOUT_COUNT + 1)];
+      for (int i=0; i<YEARLAYOUT_YEARS; i++) {
+         layout[i] = (unsigned char)findLayout(aLocale,
+               YEARLAYOUT_FIRST_YEAR + i);
+         start[layout[i] + 1]++;
+      }
+      for (int k=0; k<YEARLAYOUT_COUNT; k++) {
+         start[k + 1] += start[k];
+      }
+      vector<int> place(start, start + YEARLAYOUT_COUNT);
+      int* sorted = &years[(size_t)index * YEARLAYOUT_YEARS];
+      for (int i=0; i<YEARLAYOUT_YEARS; i++) {
+         sorted[place[layout[i]]++] = YEARLAYOUT_FIRST_YEAR + i;
+      }
+   }
+}
+
+
+
+//////////////////////////////
+//
+// YearLayout::findLayout -- the layout of a year of a locale, found
+//     without the index, or YEARLAYOUT_UNKNOWN for an unknown locale.
+//
+
+int YearLayout::findLayout(int aLocale, int year) {
+   int index = Calendar::getLocaleIndex(aLocale);
+   if (index < 0) {
+      return YEARLAYOUT_UNKNOWN;
+   }
+   int calendar = Calendar::getYearCalendar(aLocale, year);
+   if (calendar == CALENDAR_REFORMATION) {
+      return YEARLAYOUT_REFORM + index;
+   }
+   int firstDay = Calendar::niceneDay(calendar, year, 1, 1);
+   int weekday = ((firstDay % 7 - 1) + 14) % 7;
+   if (Calendar::leapYear(calendar, year)) {
+      return YEARLAYOUT_LEAP + weekday;
+   }
+   return weekday;
+}
+
+
+
+//////////////////////////////
+//
+// YearLayout::getLayout -- the layout of a year of a locale, from the
+//     index when the year is in it, or YEARLAYOUT_UNKNOWN for an unknown
+//     locale.
+//
+
+int YearLayout::getLayout(int aLocale, int year) const {
+   int index = Calendar::getLocaleIndex(aLocale);
+   if (index < 0 || layouts.empty() || year < YEARLAYOUT_FIRST_YEAR ||
+         year > YEARLAYOUT_LAST_YEAR) {
+      return findLayout(aLocale, year);
+   }
+   return layouts[(size_t)index * YEARLAYOUT_YEARS + year -
+         YEARLAYOUT_FIRST_YEAR];
+}
+
+
+
+//////////////////////////////
+//
+// YearLayout::getLayoutName -- description of a layout.
+//
+
+const char* YearLayout::getLayoutName(int layout) {
+   if (layout >= 0 && layout < YEARLAYOUT_REFORM) {
+      return layoutNames[layout];
+   } else if (layout >= YEARLAYOUT_REFORM && layout < YEARLAYOUT_COUNT) {
+      return "reform year";
+   }
+   return "unknown";
+}
+
+
+
+//////////////////////////////
+//
+// YearLayout::getSameYears -- the years of the index which have the same
+//     layout as a year of a locale (including the year itself), in
+//     increasing order.  Returns NULL with a count of 0 if the index has
+//     not been built.
+//
+
+const int* YearLayout::getSameYears(int aLocale, int year, int& count)
+      const {
+   return getYears(aLocale, getLayout(aLocale, year), count);
+}
+
+
+
+//////////////////////////////
+//
+// YearLayout::getYears -- the years of the index which have a layout in
+//     a locale, in increasing order.  Returns NULL with a count of 0 if
+//     there are none or the index has not been built.
+//
+
+const int* YearLayout::getYears(int aLocale, int layout, int& count) const {
+   count = 0;
+   int index = Calendar::getLocaleIndex(aLocale);
+   if (index < 0 || starts.empty() || layout < 0 ||
+         layout >= YEARLAYOUT_COUNT) {
+      return NULL;
+   }
+   const int* start = &starts[(size_t)index * (YEARLAYOUT_COUNT + 1)];
+   count = start[layout + 1] - start[layout];
+   if (count == 0) {
+      return NULL;
+   }
+   return &years[(size_t)index * YEARLAYOUT_YEARS + start[layout]];
+}
+
+
+
@@ -0,0 +1,69 @@
+//
+// Creation Date: Mon Oct 19 00:12:48 PDT 2026
+// Last Modified: Mon Oct 19 00:12:48 PDT 2026
+// Filename:      YearLayout.h
+// Syntax:        C++11
+//
+// Description:   Index of the layouts of the years YEARLAYOUT_FIRST_YEAR
+//                to YEARLAYOUT_LAST_YEAR in every locale.  Two years with
+//                the same layout have the same calendar apart from the
+//                year number, so a printed calendar of one can be reused
+//                for the other.  The layout of a year and the years which
+//                share it are looked up in constant time once the index
+//                is built (about 150 KB).
+//
+// Layouts 0-6 are common years and 7-13 leap years, whose 1 January falls
+// on Sunday to Saturday.  A year in which a locale changed from the Julian
+// to the Gregorian calendar (CALENDAR_REFORMATION of
+// Calendar::getYearCalendar()) has a layout of its own,
+// YEARLAYOUT_REFORM + the locale index (see Calendar::getLocaleIndex()).
+//
+
+#ifndef _YEARLAYOUT_H_INCLUDED
+#define _YEARLAYOUT_H_INCLUDED
+
+#include "Calendar.h"
+#include <vector>
+
+using namespace std;
+
+// Years in the index:
+#define YEARLAYOUT_FIRST_YEAR    1
+#define YEARLAYOUT_LAST_YEAR     9999
+
+// Layout numbers:
+#define YEARLAYOUT_UNKNOWN      -1
+#define YEARLAYOUT_LEAP          7     /* first leap year layout         */
+#define YEARLAYOUT_REFORM        14    /* reform year of locale index 0  */
+#define YEARLAYOUT_COUNT         (YEARLAYOUT_REFORM + LOCALE_COUNT)
+
+
+class YearLayout {
+   public:
+                         YearLayout      (void);
+                        ~YearLayout      ();
+
+      void               build           (void);
+      int                getLayout       (int aLocale, int year) const;
+      const int*         getSameYears    (int aLocale, int year,
+                                            int& count) const;
+      const int*         getYears        (int aLocale, int layout,
+                                            int& count) const;
+
+      static int         findLayout      (int aLocale, int year);
+      static const char* getLayoutName   (int layout);
+
+   private:
+      vector<unsigned char> layouts;     // layout of each year of each
+                                         // locale, by locale index
+      vector<int>        years;          // years of each locale, sorted by
+                                         // layout and then year
+      vector<int>        starts;         // index in years of the first year
+                                         // of each layout of each locale
+};
+
+
+#endif  // _YEARLAYOUT_H_INCLUDED
+
+
+
@@ -31,11 +31,29 @@
 //       29 Feb 300 Julian =  1 Mar 300 Gregorian proleptic
 //
 
+#include "Benchmark.h"
+#include "BulkConverter.h"
 #include "Calendar.h"
+#include "DateCache.h"
+#include "DateDump.h"
+#include "DateHistogram.h"
+#include "DateJoin.h"
+#include "DateParser.h"
+#include "DateQuery.h"
+#include "DayTable.h"
+#include "Divergence.h"
+#include "Easter.h"
 #include "Options.h"
+#include "PageStore.h"
+#include "Stats.h"
+#include "Trace.h"
+#include "YearLayout.h"
 #include <cstring>
 #include <iostream>
 #include <cstdio>
+#include <sstream>
+#include <string>
+#include <strings.h>
 
 using namespace std;
 
@@ -44,6 +62,38 @@ using namespace std;
 #define DISPLAY_YEAR      2
 #define DISPLAY_NICENE    3
 #define DISPLAY_DEBUG     4
+#define DISPLAY_CONVERT   5
+#define DISPLAY_DUMP      6
+#define DISPLAY_BUILD     7
+#define DISPLAY_JOIN      8
+#define DISPLAY_HISTOGRAM 9
+#define DISPLAY_FIND     10
+#define DISPLAY_LAYOUT   11
+#define DISPLAY_DIVERGE  12
+#define DISPLAY_WEEKDAYS 13
+#define DISPLAY_EASTER   14
+
+// options which select the display modes other than calendars:
+class DisplayMode {
+   public:
+      const char*        option;
+      int                display;
+};
+
+static const DisplayMode displayModes[] = {
+   { "convert-file",   DISPLAY_CONVERT   },
+   { "dump",           DISPLAY_DUMP      },
+   { "build-store",    DISPLAY_BUILD     },
+   { "join",           DISPLAY_JOIN      },
+   { "histogram",      DISPLAY_HISTOGRAM },
+   { "find",           DISPLAY_FIND      },
+   { "year-layout",    DISPLAY_LAYOUT    },
+   { "same-years",     DISPLAY_LAYOUT    },
+   { "divergence",     DISPLAY_DIVERGE   },
+   { "count-weekdays", DISPLAY_WEEKDAYS  },
+   { "easter",         DISPLAY_EASTER    },
+   { NULL,             DISPLAY_UNKNOWN   }
+};
 
 // global variables:
 Calendar cal;          // calendar object which will determine what
@@ -56,88 +106,195 @@ int   month       = MONTH_UNKNOWN;    // command-line year
 int   day         = DAY_UNKNOWN;      // command-line year
 int   displayType = DISPLAY_UNKNOWN;  // for deciding what to display
 int   yearDisplayType = 0;            // for regular cal style year calendar
+PageStore store;                      // pre-rendered pages, if available
+DayTable dayTable;                    // records for --engine table
 
 // function declarations:
 char*         centerline      (char* buffer, const char* string, 
                                  int linelen, char rfill = '\0');
 void          checkOptions    (Options& opts);
+int           convertFile     (Options& opts);
+int           countWeekdays   (Options& opts);
+int           divergence      (Options& opts);
+void          droppedDays     (void);
+int           dumpRange       (Options& opts);
+int           easterTable     (Options& opts);
+int           findDates       (Options& opts);
+int           getLocaleOption (Options& opts, const char* name, 
+                                 int defaultLocale);
+int           getFileLocale   (string& filename, int defaultLocale);
+int           getWeekdayMask  (const string& list);
+int           getRangeDay     (const string& date, int aLocale,
+                                 int yearEnd = 0);
+void          getRangeDays    (const string& range, const char* option,
+                                 int aLocale, int& startDay, int& endDay);
+int           histogramFiles  (Options& opts);
+int           joinFiles       (Options& opts);
 void          locales         (void);
 void          example         (void);
 void          help            (void);
 void          usage           (const char* command);
+void          writeOutput     (const string& text);
+int           yearLayout      (Options& opts);
 
 ///////////////////////////////////////////////////////////////////////////
 
 int main(int argc, char** argv) {
+   Stats::startPhase(STATS_PHASE_OPTIONS);
    options.setOptions(argc, argv);
    checkOptions(options);
    
+   stringstream output;
    char buffer[128] = {0};
    int calendar = CALENDAR_UNKNOWN;
+   int status = 0;
+   const char* pageText;
+   int pageLength;
    switch (displayType) {
+      case DISPLAY_BUILD:
+         store.setThreadCount(options.getInteger("threads"));
+         status = store.build(options.getString("build-store"));
+         break;
+      case DISPLAY_CONVERT:
+         status = convertFile(options);
+         break;
+      case DISPLAY_DUMP:
+         status = dumpRange(options);
+         break;
+      case DISPLAY_JOIN:
+         status = joinFiles(options);
+         break;
+      case DISPLAY_HISTOGRAM:
+         status = histogramFiles(options);
+         break;
+      case DISPLAY_FIND:
+         status = findDates(options);
+         break;
+      case DISPLAY_LAYOUT:
+         status = yearLayout(options);
+         break;
+      case DISPLAY_DIVERGE:
+         status = divergence(options);
+         break;
+      case DISPLAY_WEEKDAYS:
+         status = countWeekdays(options);
+         break;
+      case DISPLAY_EASTER:
+         status = easterTable(options);
+         break;
       case DISPLAY_MONTH:
          if (options.getBoolean("label")) {
+            Stats::startPhase(STATS_PHASE_CALENDAR);
             calendar = cal.getMonthCalendar();
-            cout << centerline(buffer, 
+            Stats::stopPhase(STATS_PHASE_CALENDAR);
+            output << centerline(buffer, 
                   Calendar::getCalendarName(calendar), 20, ' ');
-            cout << '\n';
+            output << '\n';
          }
-         cal.printMonth();
+         Stats::startPhase(STATS_PHASE_RENDER);
+         if (store.findPage(cal.getLocale(), cal.getYear(), 
+               cal.getMonth() - 1, pageText, pageLength)) {
+            output.write(pageText, pageLength);
+         } else {
+            cal.printMonth(output);
+         }
+         Stats::stopPhase(STATS_PHASE_RENDER);
          break;
       case DISPLAY_YEAR:
          if (options.getBoolean("label")) {
+            Stats::startPhase(STATS_PHASE_CALENDAR);
             calendar = cal.getYearCalendar();
+            Stats::stopPhase(STATS_PHASE_CALENDAR);
             if (options.getBoolean("single")) {
-               cout << centerline(buffer, 
+               output << centerline(buffer, 
                      Calendar::getCalendarName(calendar), 20, ' ');
             } else {
-               cout << centerline(buffer, 
+               output << centerline(buffer, 
                      Calendar::getCalendarName(calendar), 66, ' ');
             }
-            cout << '\n';
+            output << '\n';
+         }
+         Stats::startPhase(STATS_PHASE_RENDER);
+         if (store.findPage(cal.getLocale(), cal.getYear(), 
+               yearDisplayType == 1 ? PAGESTORE_SINGLE_PAGE : 
+               PAGESTORE_YEAR_PAGE, pageText, pageLength)) {
+            output.write(pageText, pageLength);
+         } else {
+            cal.printYear(output, yearDisplayType);
          }
-         cal.printYear(cout, yearDisplayType);
+         Stats::stopPhase(STATS_PHASE_RENDER);
          break;
       case DISPLAY_NICENE:
-         cout << "Day number is: " << cal.getNiceneDay() << " for " 
+         Stats::startPhase(STATS_PHASE_RENDER);
+         if (options.getBoolean("add-days")) {
+            int y = cal.getYear();
+            int m = cal.getMonth();
+            int d = cal.getDay();
+            Calendar::addDays(cal.getLocale(), options.getInteger("add-days"),
+                  y, m, d);
+            output << d << " " << m << " " << y << endl;
+            Stats::stopPhase(STATS_PHASE_RENDER);
+            break;
+         } else if (options.getBoolean("days-until")) {
+            // read and checked by checkOptions():
+            int y, m, d;
+            DateParser::parse(options.getString("days-until").c_str(),
+                  y, m, d);
+            output << Calendar::daysBetween(cal.getLocale(), cal.getYear(),
+                  cal.getMonth(), cal.getDay(), y, m, d) << endl;
+            Stats::stopPhase(STATS_PHASE_RENDER);
+            break;
+         }
+         output << "Day number is: " << cal.getNiceneDay() << " for " 
               << Calendar::getCalendarName(
                  Calendar::getCalendar(cal.getLocale(), cal.getNiceneDay()))
               << " calendar" << endl;
-              break;
+         Stats::stopPhase(STATS_PHASE_RENDER);
+         break;
       case DISPLAY_DEBUG:
-         cout << "Julian Nicene day is: " 
+         Stats::startPhase(STATS_PHASE_RENDER);
+         output << "Julian Nicene day is: " 
               << Calendar::niceneDay(CALENDAR_JULIAN, year, month, day) 
               << endl;
-         cout << "Gregorian Nicene day is: " 
+         output << "Gregorian Nicene day is: " 
               << Calendar::niceneDay(CALENDAR_GREGORIAN, year, month, day) 
               << endl;
-         cout << "Julian Year is: "
+         output << "Julian Year is: "
               << Calendar::getYear(CALENDAR_JULIAN, 
                     Calendar::niceneDay(CALENDAR_JULIAN, year, month, day))
               << endl;
-         cout << "Gregorian Year is: "
+         output << "Gregorian Year is: "
               << Calendar::getYear(CALENDAR_GREGORIAN, 
                     Calendar::niceneDay(CALENDAR_GREGORIAN, year, month, day))
               << endl;
-         cout << "Julian Month is: "
+         output << "Julian Month is: "
               << Calendar::getMonth(CALENDAR_JULIAN, 
                     Calendar::niceneDay(CALENDAR_JULIAN, year, month, day))
               << endl;
-         cout << "Gregorian Month is: "
+         output << "Gregorian Month is: "
               << Calendar::getMonth(CALENDAR_GREGORIAN, 
                     Calendar::niceneDay(CALENDAR_GREGORIAN, year, month, day))
               << endl;
-         cout << "Julian Day is: "
+         output << "Julian Day is: "
               << Calendar::getDay(CALENDAR_JULIAN, 
                     Calendar::niceneDay(CALENDAR_JULIAN, year, month, day))
               << endl;
-         cout << "Gregorian Day is: "
+         output << "Gregorian Day is: "
               << Calendar::getDay(CALENDAR_GREGORIAN, 
                     Calendar::niceneDay(CALENDAR_GREGORIAN, year, month, day))
               << endl;
+         Stats::stopPhase(STATS_PHASE_RENDER);
    }
 
-   return 0;
+   if (output.tellp() > 0) {
+      writeOutput(output.str());
+   }
+
+   if (Stats::isEnabled()) {
+      Stats::print(cerr);
+   }
+
+   return status;
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -181,6 +338,8 @@ char* centerline(char* buffer, const char* string, int linelen, char rfill) {
 //
 
 void checkOptions(Options& opts) {
+   long long traceStart = Trace::now();
+
    // calendar type options
    opts.define("gregorian|Gregorian|g=b");
    opts.define("julian|Julian|j=b");
@@ -207,6 +366,40 @@ void checkOptions(Options& opts) {
    opts.define("label=b");                   // list type of calendar printed
    opts.define("locales=b");                 // print a list of locales
    opts.define("early=b");                   // if using a small year number
+   opts.define("stats=b");                   // print timing and counters
+   opts.define("trace=s");                   // write trace events to file
+   opts.define("benchmark=b");               // run conversion benchmarks
+   opts.define("perf=b");                    // hardware counters in benchmark
+   opts.define("benchmark-scale=d:1.0");     // benchmark operation multiplier
+   opts.define("convert-file=s");            // convert a file of dates
+   opts.define("from=s");                    // locale of input dates
+   opts.define("to=s");                      // locale of output dates
+   opts.define("threads=i:0");               // worker threads (0 = all cores)
+   opts.define("dump=s");                    // per-day table of a date range
+   opts.define("locale=s");                  // locale of --dump dates
+   opts.define("format=s");                  // --dump/--convert-file format
+   opts.define("cache=b");                   // cache conversions and renders
+   opts.define("build-store=s");             // write a file of rendered pages
+   opts.define("store=s");                   // serve pages from a store file
+   opts.define("engine=s:arithmetic");       // date conversion engine
+   opts.define("day-table=s");               // table engine from a file
+   opts.define("build-day-table=s");         // write a day table file
+   opts.define("join=b");                    // join record files by day
+   opts.define("join-mode=s:merge");         // merge, inner or aligned
+   opts.define("histogram=s");               // count dates by week, etc.
+   opts.define("find=s");                    // days matching a predicate
+   opts.define("range=s:1..9999");           // days searched by --find
+   opts.define("find-output=s:days");        // days, years or count
+   opts.define("year-layout=s");             // layout number of a year
+   opts.define("same-years=s");              // years with the same layout
+   opts.define("divergence=s");              // days two locales differ
+   opts.define("on=s");                      // --divergence offset on a day
+   opts.define("check-dates=b");             // flag dates which never existed
+   opts.define("dropped-days=b");            // list the dates of each reform
+   opts.define("add-days=i");                // date a number of days later
+   opts.define("days-until=s");              // days from the date to another
+   opts.define("count-weekdays=s");          // days of weekdays in --range
+   opts.define("easter=s");                  // Easter days of a year range
 
    // standard options
    opts.define("author=b");
@@ -216,6 +409,44 @@ void checkOptions(Options& opts) {
    opts.define("example=b");
    options.process();
 
+   if (opts.getBoolean("stats")) {
+      Stats::enable();
+   }
+   if (opts.getBoolean("trace")) {
+      Trace::enable(opts.getString("trace"));
+   }
+   if (opts.getBoolean("cache")) {
+      DateCache::enable();
+   }
+
+   // choose the engine for converting Nicene days to dates:
+   if (opts.getBoolean("build-day-table")) {
+      dayTable.build(opts.getInteger("threads"));
+      if (dayTable.save(opts.getString("build-day-table")) != 0) {
+         cerr << "Error: cannot write " << opts.getString("build-day-table")
+              << endl;
+         exit(1);
+      }
+      exit(0);
+   }
+   if (opts.getBoolean("day-table")) {
+      if (!dayTable.open(opts.getString("day-table"))) {
+         cerr << "Error: cannot read the day table "
+              << opts.getString("day-table") << endl;
+         exit(1);
+      }
+      Calendar::setDayTable(&dayTable);
+   } else if (opts.getString("engine") == "table") {
+      dayTable.build(opts.getInteger("threads"));
+      Calendar::setDayTable(&dayTable);
+   } else if (opts.getString("engine") != "arithmetic") {
+      cerr << "Error: unknown engine \"" << opts.getString("engine")
+           << "\".  Use arithmetic or table." << endl;
+      exit(1);
+   }
+   Stats::stopPhase(STATS_PHASE_OPTIONS);
+
+   Stats::startPhase(STATS_PHASE_LOCALE);
    int locale = LOCALE_UNKNOWN;
    // set the locale type variable:
    if (opts.getBoolean("Gregorian")) {
@@ -258,8 +489,9 @@ void checkOptions(Options& opts) {
    } else if (opts.getBoolean("Julian")) {
       locale = LOCALE_JULIAN;
    }
+   Stats::stopPhase(STATS_PHASE_LOCALE);
 
-
+   Stats::startPhase(STATS_PHASE_OPTIONS);
    if (opts.getBoolean("author")) {
       cout << "Written by Craig Stuart Sapp, "
               "craig@ccrma.stanford.edu, \n"
@@ -281,6 +513,14 @@ void checkOptions(Options& opts) {
    } else if (opts.getBoolean("locales")) {
       locales();
       exit(0);
+   } else if (opts.getBoolean("dropped-days")) {
+      droppedDays();
+      exit(0);
+   } else if (opts.getBoolean("benchmark")) {
+      Benchmark benchmark;
+      benchmark.setCounters(opts.getBoolean("perf"));
+      benchmark.setScale(opts.getDouble("benchmark-scale"));
+      exit(benchmark.run(cout));
    }
    
    if (opts.getBoolean("single")) {
@@ -289,25 +529,63 @@ void checkOptions(Options& opts) {
       yearDisplayType = 0;
    }
 
+   cal.setLocale(locale);
+   // options which select a mode other than a calendar, at most one:
+   const char* modeOption = NULL;
+   for (int i=0; displayModes[i].option != NULL; i++) {
+      if (!opts.getBoolean(displayModes[i].option)) {
+         continue;
+      }
+      if (modeOption != NULL) {
+         cerr << "Error: --" << modeOption << " and --"
+              << displayModes[i].option << " cannot be used together"
+              << endl;
+         exit(1);
+      }
+      modeOption = displayModes[i].option;
+      displayType = displayModes[i].display;
+   }
+   if (modeOption != NULL) {
+      Stats::stopPhase(STATS_PHASE_OPTIONS);
+      Trace::record("options", traceStart, Trace::now() - traceStart);
+      return;
+   }
+
    switch (opts.getArgCount()) {
       case 1:
-         std::sscanf(opts.getArg(1).c_str(), "%d", &year);
+         if (DateParser::parse(opts.getArg(1).c_str(), year, month, day)) {
+            displayType = DISPLAY_NICENE;
+            break;
+         }
+         if (!DateParser::parseYear(opts.getArg(1).c_str(), year)) {
+            cout << "Error: cannot read the date \"" << opts.getArg(1) 
+                 << "\"" << endl;
+            exit(1);
+         }
          month = 1;
          day = 1;
          displayType = DISPLAY_YEAR;
          break;
       case 2:
-         std::sscanf(opts.getArg(1).c_str(), "%d", &month);
+         month = DateParser::lookupMonth(opts.getArg(1).c_str());
+         if (month == 0) {
+            month = MONTH_UNKNOWN;
+            std::sscanf(opts.getArg(1).c_str(), "%d", &month);
+         }
          std::sscanf(opts.getArg(2).c_str(), "%d", &year);
          day = 1;
          displayType = DISPLAY_MONTH;
          break;
-      case 3:
-         std::sscanf(opts.getArg(1).c_str(), "%d", &day);
-         std::sscanf(opts.getArg(2).c_str(), "%d", &month);
-         std::sscanf(opts.getArg(3).c_str(), "%d", &year);
+      case 3: {
+         string date = opts.getArg(1) + " " + opts.getArg(2) + " " + 
+               opts.getArg(3);
+         if (!DateParser::parse(date.c_str(), year, month, day)) {
+            cout << "Error: cannot read the date \"" << date << "\"" << endl;
+            exit(1);
+         }
          displayType = DISPLAY_NICENE;
          break;
+      }
      default: 
          usage(opts.getCommand().c_str());
          exit(1);
@@ -324,7 +602,557 @@ void checkOptions(Options& opts) {
       exit(1);
    }
 
+   // use a page store given with --store or in HCAL_STORE:
+   string storeName;
+   if (opts.getBoolean("store")) {
+      storeName = opts.getString("store");
+   } else if (getenv("HCAL_STORE") != NULL) {
+      storeName = getenv("HCAL_STORE");
+   }
+   if (!storeName.empty() &&
+         (displayType == DISPLAY_MONTH || displayType == DISPLAY_YEAR) &&
+         !store.open(storeName)) {
+      cerr << "Warning: cannot use the page store " << storeName << endl;
+   }
+   Stats::stopPhase(STATS_PHASE_OPTIONS);
+   Trace::record("options", traceStart, Trace::now() - traceStart);
+
+   // date arithmetic needs a full date, and both dates must exist:
+   if (opts.getBoolean("add-days") || opts.getBoolean("days-until")) {
+      const char* option = opts.getBoolean("add-days") ? "add-days" :
+            "days-until";
+      if (opts.getBoolean("add-days") && opts.getBoolean("days-until")) {
+         cerr << "Error: --add-days and --days-until cannot be used "
+                 "together" << endl;
+         exit(1);
+      }
+      if (displayType != DISPLAY_NICENE) {
+         cerr << "Error: --" << option << " needs a full date, for example "
+              << "hcal --" << option << " "
+              << opts.getString(option) << " 2 9 1752" << endl;
+         exit(1);
+      }
+      int y = year;
+      int m = month;
+      int d = day;
+      if (opts.getBoolean("days-until") &&
+            !DateParser::parse(opts.getString("days-until").c_str(),
+            y, m, d)) {
+         cerr << "Error: cannot read the date \""
+              << opts.getString("days-until") << "\"" << endl;
+         exit(1);
+      }
+      int dates[2][3] = { { year, month, day }, { y, m, d } };
+      for (int k=0; k<2; k++) {
+         if (!Calendar::isValidDate(locale, dates[k][0], dates[k][1],
+               dates[k][2])) {
+            cerr << "Error: " << dates[k][2] << " " << dates[k][1] << " "
+                 << dates[k][0] << " did not exist in the "
+                 << Calendar::getLocaleName(locale) << " locale" << endl;
+            exit(1);
+         }
+      }
+   } else if (displayType == DISPLAY_NICENE &&
+         !Calendar::isValidDate(locale, year, month, day)) {
+      cerr << "Warning: " << day << " " << month << " " << year
+           << " did not exist in the " << Calendar::getLocaleName(locale)
+           << " locale" << endl;
+   }
+
+   Stats::startPhase(STATS_PHASE_CALENDAR);
    cal.setDate(year, month, day, locale);
+   Stats::stopPhase(STATS_PHASE_CALENDAR);
+}
+
+
+
+//////////////////////////////
+//
+// convertFile -- convert the dates in the --convert-file file from the
+//    --from locale (or the locale options) to the --to locale (Gregorian
+//    by default).
+//
+
+int convertFile(Options& opts) {
+   BulkConverter converter;
+   converter.setFromLocale(getLocaleOption(opts, "from", cal.getLocale()));
+   converter.setToLocale(getLocaleOption(opts, "to", LOCALE_GREGORIAN));
+   converter.setThreadCount(opts.getInteger("threads"));
+   converter.setCheckDates(opts.getBoolean("check-dates"));
+   if (opts.getBoolean("format")) {
+      string name = opts.getString("format");
+      if (name == "columnar") {
+         converter.setFormat(BULK_FORMAT_COLUMNAR);
+      } else if (name == "delta") {
+         converter.setFormat(BULK_FORMAT_DELTA);
+      } else if (name != "text") {
+         cerr << "Error: unknown format \"" << name
+              << "\" for --convert-file.  Use text, columnar or delta."
+              << endl;
+         exit(1);
+      }
+   }
+   return converter.convertFile(opts.getString("convert-file"), stdout);
+}
+
+
+
+//////////////////////////////
+//
+// countWeekdays -- write the number of days of the --range (dates or
+//    years of the --locale locale or the locale options) whose weekday is
+//    in the --count-weekdays list.
+//
+
+int countWeekdays(Options& opts) {
+   int aLocale = getLocaleOption(opts, "locale", cal.getLocale());
+   int mask = getWeekdayMask(opts.getString("count-weekdays"));
+   int startDay, endDay;
+   getRangeDays(opts.getString("range"), "range", aLocale, startDay, endDay);
+   char buffer[32];
+   writeOutput(string(buffer, snprintf(buffer, sizeof(buffer), "%d\n",
+         Calendar::countWeekdays(startDay, endDay, mask))));
+   return 0;
+}
+
+
+
+//////////////////////////////
+//
+// divergence -- write the intervals of the --range (dates or years of the
+//    first locale) on which the two --divergence locales, such as
+//    england,france, use different calendars, with the number of days the
+//    date in the second locale is ahead of the date in the first.  With
+//    --on, write only that number for one date of the first locale.
+//
+
+int divergence(Options& opts) {
+   string names = opts.getString("divergence");
+   size_t comma = names.find(',');
+   int localeA = LOCALE_UNKNOWN;
+   int localeB = LOCALE_UNKNOWN;
+   if (comma != string::npos) {
+      localeA = Calendar::getLocaleByName(names.substr(0, comma).c_str());
+      localeB = Calendar::getLocaleByName(names.substr(comma + 1).c_str());
+   }
+   if (localeA == LOCALE_UNKNOWN || localeB == LOCALE_UNKNOWN) {
+      cerr << "Error: --divergence needs two locales, for example "
+              "england,france" << endl;
+      exit(1);
+   }
+
+   vector<Divergence::Interval> intervals;
+   if (opts.getBoolean("on")) {
+      int aDay = getRangeDay(opts.getString("on"), localeA);
+      Divergence::getIntervals(localeA, localeB, aDay, aDay, intervals);
+      char buffer[32];
+      writeOutput(string(buffer, snprintf(buffer, sizeof(buffer), "%+d\n",
+            Divergence::findOffset(intervals, aDay))));
+      return 0;
+   }
+
+   int startDay, endDay;
+   getRangeDays(opts.getString("range"), "range", localeA, startDay, endDay);
+   Divergence::getIntervals(localeA, localeB, startDay, endDay, intervals);
+   string text;
+   char buffer[64];
+   int y1, m1, d1, y2, m2, d2;
+   for (size_t i=0; i<intervals.size(); i++) {
+      Calendar::getDate(localeA, intervals[i].first, y1, m1, d1);
+      Calendar::getDate(localeA, intervals[i].last, y2, m2, d2);
+      text.append(buffer, snprintf(buffer, sizeof(buffer),
+            "%04d-%02d-%02d..%04d-%02d-%02d\t%+d\n", y1, m1, d1, y2, m2, d2,
+            intervals[i].offset));
+   }
+   writeOutput(text);
+   return 0;
+}
+
+
+
+//////////////////////////////
+//
+// droppedDays -- write the dates which the reform of each locale left
+//    out, with their number.
+//
+
+void droppedDays(void) {
+   int years[CALENDAR_DROPPED_SIZE];
+   int months[CALENDAR_DROPPED_SIZE];
+   int days[CALENDAR_DROPPED_SIZE];
+   string text;
+   char buffer[128];
+   for (int i=0; i<Calendar::getLocaleCount(); i++) {
+      int aLocale = Calendar::getLocaleByIndex(i);
+      int count = Calendar::getDroppedDays(aLocale, years, months, days,
+            CALENDAR_DROPPED_SIZE);
+      if (count == 0) {
+         continue;
+      }
+      int last = count < CALENDAR_DROPPED_SIZE ? count - 1 :
+            CALENDAR_DROPPED_SIZE - 1;
+      text.append(buffer, snprintf(buffer, sizeof(buffer),
+            "%s\t%04d-%02d-%02d..%04d-%02d-%02d\t%d\n",
+            Calendar::getLocaleName(aLocale), years[0], months[0], days[0],
+            years[last], months[last], days[last], count));
+   }
+   writeOutput(text);
+}
+
+
+
+//////////////////////////////
+//
+// dumpRange -- write the per-day table for the --dump range, given as
+//    "start..end" dates in the --locale locale (or the locale options).
+//
+
+int dumpRange(Options& opts) {
+   int aLocale = getLocaleOption(opts, "locale", cal.getLocale());
+   int aFormat = DUMP_FORMAT_CSV;
+   if (opts.getBoolean("format")) {
+      aFormat = DateDump::getFormatByName(opts.getString("format").c_str());
+   }
+   if (aFormat == DUMP_FORMAT_UNKNOWN) {
+      cerr << "Error: unknown format \"" << opts.getString("format")
+           << "\" for --dump.  Use csv, binary, columnar or delta."
+           << endl;
+      exit(1);
+   }
+
+   int startDay, endDay;
+   getRangeDays(opts.getString("dump"), "dump", aLocale, startDay, endDay);
+
+   DateDump dumper;
+   dumper.setLocale(aLocale);
+   dumper.setFormat(aFormat);
+   dumper.setThreadCount(opts.getInteger("threads"));
+   return dumper.dump(startDay, endDay, stdout);
+}
+
+
+
+//////////////////////////////
+//
+// easterTable -- write the date of Easter Sunday in each year of the
+//    --easter range (such as 1500-2100, or a single year) in the locale
+//    of the locale options, with the calendar whose rule was used.
+//
+
+int easterTable(Options& opts) {
+   string range = opts.getString("easter");
+   size_t separator = range.find("..");
+   size_t length = 2;
+   if (separator == string::npos) {
+      separator = range.find('-', 1);
+      length = 1;
+   }
+   if (separator == string::npos) {
+      separator = range.size();
+   }
+   int firstYear = 0;
+   int lastYear = 0;
+   if (!DateParser::parseYear(range.substr(0, separator).c_str(),
+         firstYear)) {
+      firstYear = 0;
+   }
+   if (separator == range.size()) {
+      lastYear = firstYear;
+   } else if (!DateParser::parseYear(
+         range.substr(separator + length).c_str(), lastYear)) {
+      lastYear = 0;
+   }
+   if (firstYear < 1 || lastYear < firstYear || lastYear > CALENDAR_MAX_YEAR) {
+      cerr << "Error: --easter needs a year or a range of years from 1 to "
+           << CALENDAR_MAX_YEAR << ", for example 1500-2100" << endl;
+      exit(1);
+   }
+
+   int aLocale = cal.getLocale();
+   int count = lastYear - firstYear + 1;
+   vector<int> ndays(count);
+   vector<int> years(count);
+   vector<int> months(count);
+   vector<int> days(count);
+   Easter::fillTable(aLocale, firstYear, count, ndays.data());
+   Calendar::getDates(aLocale, ndays.data(), years.data(), months.data(),
+         days.data(), count);
+   string text;
+   char buffer[64];
+   for (int i=0; i<count; i++) {
+      text.append(buffer, snprintf(buffer, sizeof(buffer),
+            "%d\t%04d-%02d-%02d\t%s\n", firstYear + i, years[i], months[i],
+            days[i], Calendar::getCalendarName(
+            Calendar::getCalendar(aLocale, ndays[i]))));
+   }
+   writeOutput(text);
+   return 0;
+}
+
+
+
+//////////////////////////////
+//
+// findDates -- write the days of the --range (years or dates of the
+//    --locale locale or the locale options) which match the --find
+//    predicate.
+//
+
+int findDates(Options& opts) {
+   int aLocale = getLocaleOption(opts, "locale", cal.getLocale());
+   int anOutput = DateQuery::getOutputByName(
+         opts.getString("find-output").c_str());
+   if (anOutput == QUERY_OUTPUT_UNKNOWN) {
+      cerr << "Error: unknown --find-output \"" << opts.getString("find-output")
+           << "\".  Use days, years or count." << endl;
+      exit(1);
+   }
+   DateQuery query;
+   query.setLocale(aLocale);
+   query.setOutput(anOutput);
+   query.setThreadCount(opts.getInteger("threads"));
+   if (!query.parse(opts.getString("find"))) {
+      cerr << "Error: cannot read the --find predicate: " << query.getError()
+           << endl;
+      exit(1);
+   }
+   int startDay, endDay;
+   getRangeDays(opts.getString("range"), "range", aLocale, startDay, endDay);
+   return query.find(startDay, endDay, stdout);
+}
+
+
+
+//////////////////////////////
+//
+// getRangeDay -- returns the Nicene day of a date in the given locale,
+//    exiting with an error if the date cannot be read.  A year alone
+//    stands for its first day, or for its last day if yearEnd is true.
+//    default value: yearEnd = 0
+//
+
+int getRangeDay(const string& date, int aLocale, int yearEnd) {
+   int y, m, d;
+   if (DateParser::parse(date.c_str(), y, m, d)) {
+      return Calendar::niceneDay(Calendar::getCalendar(aLocale, y, m, d),
+            y, m, d);
+   }
+   if (!DateParser::parseYear(date.c_str(), y)) {
+      cerr << "Error: cannot read the date \"" << date << "\"" << endl;
+      exit(1);
+   }
+   if (yearEnd) {
+      return Calendar::firstDayFrom(aLocale, y + 1, 1, 1) - 1;
+   }
+   return Calendar::firstDayFrom(aLocale, y, 1, 1);
+}
+
+
+
+//////////////////////////////
+//
+// getRangeDays -- read a "start..end" range of dates or years of the
+//    given locale for an option, exiting with an error if it cannot be
+//    read.
+//
+
+void getRangeDays(const string& range, const char* option, int aLocale,
+      int& startDay, int& endDay) {
+   size_t separator = range.find("..");
+   if (separator == string::npos) {
+      cerr << "Error: --" << option << " range must be start..end, for "
+              "example 1500-01-01..1800-12-31 or 1500..1800" << endl;
+      exit(1);
+   }
+   startDay = getRangeDay(range.substr(0, separator), aLocale);
+   endDay = getRangeDay(range.substr(separator + 2), aLocale, 1);
+   if (endDay < startDay) {
+      cerr << "Error: --" << option << " range ends before it starts"
+           << endl;
+      exit(1);
+   }
+}
+
+
+
+//////////////////////////////
+//
+// getFileLocale -- returns the locale of a file argument of --join or
+//    --histogram, which may start with a locale name and a colon, as in
+//    england:letters.txt, and removes the prefix from the file name.
+//    Files without a prefix are in the default locale.
+//
+
+int getFileLocale(string& filename, int defaultLocale) {
+   size_t colon = filename.find(':');
+   if (colon == string::npos) {
+      return defaultLocale;
+   }
+   int aLocale = Calendar::getLocaleByName(filename.substr(0, colon).c_str());
+   if (aLocale == LOCALE_UNKNOWN) {
+      return defaultLocale;
+   }
+   filename = filename.substr(colon + 1);
+   return aLocale;
+}
+
+
+
+//////////////////////////////
+//
+// getWeekdayMask -- returns the weekday mask of Calendar::countWeekdays()
+//    for a comma-separated list of weekday names or abbreviations and
+//    ranges of them, such as sun, mon-fri or sat,sun.  The names
+//    workdays (Monday to Friday) and all may also be used.  Exits with
+//    an error if the list cannot be read.
+//
+
+int getWeekdayMask(const string& list) {
+   static const char* names[] = {
+      "sunday", "monday", "tuesday", "wednesday", "thursday", "friday",
+      "saturday"
+   };
+   int mask = 0;
+   size_t start = 0;
+   while (start <= list.size()) {
+      size_t comma = list.find(',', start);
+      if (comma == string::npos) {
+         comma = list.size();
+      }
+      string item = list.substr(start, comma - start);
+      start = comma + 1;
+      if (strcasecmp(item.c_str(), "workdays") == 0) {
+         mask |= WEEKDAY_MASK_WORKDAYS;
+         continue;
+      } else if (strcasecmp(item.c_str(), "all") == 0) {
+         mask |= WEEKDAY_MASK_ALL;
+         continue;
+      }
+      // a name, or a range of names which may wrap past Saturday:
+      size_t dash = item.find('-');
+      string ends[2];
+      ends[0] = item.substr(0, dash);
+      ends[1] = dash == string::npos ? ends[0] : item.substr(dash + 1);
+      int days[2] = { -1, -1 };
+      for (int k=0; k<2; k++) {
+         for (int w=0; w<7; w++) {
+            if (ends[k].size() >= 2 && strncasecmp(ends[k].c_str(), names[w],
+                  ends[k].size()) == 0) {
+               days[k] = w;
+               break;
+            }
+         }
+      }
+      if (days[0] < 0 || days[1] < 0) {
+         cerr << "Error: cannot read the weekday \"" << item
+              << "\".  Use names such as sun, mon-fri or workdays." << endl;
+         exit(1);
+      }
+      for (int w=days[0]; ; w=(w+1)%7) {
+         mask |= 1 << w;
+         if (w == days[1]) {
+            break;
+         }
+      }
+   }
+   return mask;
+}
+
+
+
+//////////////////////////////
+//
+// histogramFiles -- write the number of dates in the file arguments per
+//    --histogram bucket of the --to locale (Gregorian by default).  Files
+//    are in the --from locale (or the locale options) unless they have a
+//    locale prefix (see getFileLocale()).
+//
+
+int histogramFiles(Options& opts) {
+   int aBucket = DateHistogram::getBucketByName(
+         opts.getString("histogram").c_str());
+   if (aBucket == HISTOGRAM_BUCKET_UNKNOWN) {
+      cerr << "Error: unknown --histogram bucket \""
+           << opts.getString("histogram") << "\".  Use week, month or year."
+           << endl;
+      exit(1);
+   }
+   if (opts.getArgCount() < 1) {
+      cerr << "Error: --histogram needs one or more files of dates" << endl;
+      exit(1);
+   }
+
+   int defaultLocale = getLocaleOption(opts, "from", cal.getLocale());
+   DateHistogram histogram;
+   histogram.setBucket(aBucket);
+   histogram.setToLocale(getLocaleOption(opts, "to", LOCALE_GREGORIAN));
+   histogram.setThreadCount(opts.getInteger("threads"));
+   for (int i=1; i<=opts.getArgCount(); i++) {
+      string filename = opts.getArg(i);
+      int aLocale = getFileLocale(filename, defaultLocale);
+      if (!histogram.countFile(filename, aLocale)) {
+         return 1;
+      }
+   }
+   return histogram.write(stdout);
+}
+
+
+
+//////////////////////////////
+//
+// joinFiles -- write the records of the --join files in day order.  Files
+//    are in the --from locale (or the locale options) unless they have a
+//    locale prefix (see getFileLocale()).  Dates are written in the --to
+//    locale (Gregorian by default).
+//
+
+int joinFiles(Options& opts) {
+   int aMode = DateJoin::getModeByName(opts.getString("join-mode").c_str());
+   if (aMode == DATEJOIN_MODE_UNKNOWN) {
+      cerr << "Error: unknown --join-mode \"" << opts.getString("join-mode")
+           << "\".  Use merge, inner or aligned." << endl;
+      exit(1);
+   }
+   if (opts.getArgCount() < 1) {
+      cerr << "Error: --join needs one or more record files" << endl;
+      exit(1);
+   }
+
+   int defaultLocale = getLocaleOption(opts, "from", cal.getLocale());
+   DateJoin joiner;
+   joiner.setMode(aMode);
+   joiner.setToLocale(getLocaleOption(opts, "to", LOCALE_GREGORIAN));
+   joiner.setThreadCount(opts.getInteger("threads"));
+   for (int i=1; i<=opts.getArgCount(); i++) {
+      string filename = opts.getArg(i);
+      int aLocale = getFileLocale(filename, defaultLocale);
+      if (!joiner.addFile(filename, aLocale)) {
+         return 1;
+      }
+   }
+   return joiner.join(stdout);
+}
+
+
+
+//////////////////////////////
+//
+// getLocaleOption -- returns the locale named by a string option, or the
+//    default locale if the option was not given.
+//
+
+int getLocaleOption(Options& opts, const char* name, int defaultLocale) {
+   if (!opts.getBoolean(name)) {
+      return defaultLocale;
+   }
+   int aLocale = Calendar::getLocaleByName(opts.getString(name).c_str());
+   if (aLocale == LOCALE_UNKNOWN) {
+      cerr << "Error: unknown locale \"" << opts.getString(name)
+           << "\" for --" << name << ".  Use --locales for a list." << endl;
+      exit(1);
+   }
+   return aLocale;
 }
 
 
@@ -448,8 +1276,152 @@ void usage (const char* command) {
    "-t   generates a calendar for Turkey by dropping the days\n"
    "        19-31 December from the year 1926.\n"
    "\n"
+   "--stats  print timing and call counts to standard error.\n"
+   "--trace=file.json  write Chrome/Perfetto trace events to the file.\n"
+   "--benchmark  time the conversion and rendering functions.\n"
+   "--perf  add hardware counters per operation to --benchmark (Linux).\n"
+   "--benchmark-scale=x  multiply the benchmark operation counts by x.\n"
+   "--convert-file file  convert a file of dates (one date on each\n"
+   "        line) from the --from locale to the --to locale, for example\n"
+   "        --convert-file dates.txt --from england --to gregorian.\n"
+   "        The file may also be a delta stream of Nicene days.\n"
+   "--threads n  number of worker threads (default: all cores).\n"
+   "--build-store file  write every month and year page of the years\n"
+   "        1-9999 in every locale to a file.\n"
+   "--store file  print pages from a file written by --build-store when\n"
+   "        it has them (default: the HCAL_STORE environment variable).\n"
+   "--engine arithmetic|table  convert Nicene days to dates with\n"
+   "        arithmetic (default) or by looking them up in a table of the\n"
+   "        years 1-9999 (about 15 MB, built at startup).\n"
+   "--day-table file  use the table engine with a table file written\n"
+   "        by --build-day-table, which is mapped instead of built.\n"
+   "--build-day-table file  write the table of the table engine.\n"
+   "--cache  keep recent date conversions and rendered months in a\n"
+   "        cache shared by all threads; --stats shows its hit counts.\n"
+   "--join [locale:]file ...  write the records of the files (a date,\n"
+   "        then optionally a tab and more fields, on each line) in day\n"
+   "        order with the date in the --to locale, for example --join\n"
+   "        england:letters.txt france:sources.txt.  Files without a\n"
+   "        locale are in the --from locale.\n"
+   "--join-mode merge|inner|aligned  write every record (default), only\n"
+   "        the days found in every file, or one line per day with a\n"
+   "        column for each file.\n"
+   "--histogram week|month|year [locale:]file ...  count the dates in\n"
+   "        the files (as for --join) by week, month or year of the --to\n"
+   "        locale.  Each line has the bucket, the count and the number\n"
+   "        of days in the bucket, which leaves out days dropped by a\n"
+   "        reform (September 1752 in England has 19 days).\n"
+   "--find predicate  write the days of the --range which match the\n"
+   "        predicate, in the --locale locale, for example --find\n"
+   "        \"weekday = fri and day = 13\" --range 1500..1900 --locale\n"
+   "        russia.  The fields weekday, day, month, year and calendar\n"
+   "        are compared with =, !=, <, <=, > and >= and joined with\n"
+   "        and, or, not and parentheses.  A field may name a locale, as\n"
+   "        in julian.month = dec.  See src/DateQuery.h.\n"
+   "--count-weekdays days  write the number of days of the --range in\n"
+   "        the --locale locale whose weekday is one of the days, for\n"
+   "        example sun, sat,sun, mon-fri or workdays.  Days dropped by\n"
+   "        a reform are not counted.\n"
+   "--easter first-last  write the date of Easter Sunday in each year\n"
+   "        of the range (or in one year) in the locale, by the Julian\n"
+   "        or the Gregorian rule of the calendar the locale then used,\n"
+   "        for example --easter 1500-2100 -e.\n"
+   "--range start..end  dates or years of --find, --divergence and\n"
+   "        --count-weekdays (default: 1..9999).\n"
+   "--find-output days|years|count  write the matching days (default),\n"
+   "        the years which have one, or the number of them.\n"
+   "--year-layout year  write the layout number of the year (0-6 for\n"
+   "        common years starting on Sunday to Saturday, 7-13 for leap\n"
+   "        years, and one number for the reform year of each locale).\n"
+   "--same-years year  write the years 1-9999 which have the same\n"
+   "        calendar as the year, apart from the year number.\n"
+   "--divergence locale,locale  write the days of the --range (in the\n"
+   "        first locale) on which the two locales use different\n"
+   "        calendars, and how many days the date in the second locale\n"
+   "        is ahead, for example --divergence england,france.\n"
+   "--on date  with --divergence, write only the number of days for\n"
+   "        the date of the first locale.\n"
+   "--dump start..end  write one record per day of the range, for example\n"
+   "        --dump 1500-01-01..1800-12-31 --locale england.  The ends may\n"
+   "        also be years.\n"
+   "--format csv|binary|columnar|delta  output format of --dump\n"
+   "        (default: csv).\n"
+   "--format text|columnar|delta  output format of --convert-file\n"
+   "        (default: text).  The columnar layout is described in\n"
+   "        src/ColumnarFormat.h and the delta layout (Nicene days only)\n"
+   "        in src/DeltaStream.h.\n"
+   "--check-dates  with --convert-file, write \"!\" for dates which\n"
+   "        did not exist in the --from locale, such as 5 September 1752\n"
+   "        in England or 30 February.\n"
+   "--dropped-days  write the dates dropped by the reform of each\n"
+   "        locale.\n"
+   "--add-days n  write the date n days after the given date (before it\n"
+   "        if n is negative), for example hcal --add-days 1 2 9 1752.\n"
+   "--days-until date  write the number of days from the given date to\n"
+   "        this date, leaving out days dropped by a reform.\n"
+   "\n"
+   "Dates may be given as day month year (14 9 1752), 1752-09-14,\n"
+   "14 Sep 1752 or \"September 14, 1752\", with month names in English,\n"
+   "Latin and the languages of the locales.  An Old Style/New Style year\n"
+   "such as 1750/51 is read as the later year.\n"
+   "\n"
    << endl;
 }
 
 
 
+//////////////////////////////
+//
+// writeOutput -- write the rendered calendar to standard output in
+//     a single write.
+//
+
+void writeOutput(const string& text) {
+   TraceSpan span("output");
+   Stats::startPhase(STATS_PHASE_OUTPUT);
+   fwrite(text.data(), 1, text.size(), stdout);
+   fflush(stdout);
+   Stats::recordWrite(text.size());
+   Stats::stopPhase(STATS_PHASE_OUTPUT);
+}
+
+
+
+//////////////////////////////
+//
+// yearLayout -- write the layout of the --year-layout year, or the years
+//     1-9999 which have the same calendar as the --same-years year, in
+//     the locale of the locale options.
+//
+
+int yearLayout(Options& opts) {
+   const char* option = opts.getBoolean("same-years") ? "same-years" :
+         "year-layout";
+   int aYear;
+   if (!DateParser::parseYear(opts.getString(option).c_str(), aYear)) {
+      cerr << "Error: cannot read the year \"" << opts.getString(option)
+           << "\" for --" << option << endl;
+      exit(1);
+   }
+   int aLocale = cal.getLocale();
+   if (strcmp(option, "year-layout") == 0) {
+      int layout = YearLayout::findLayout(aLocale, aYear);
+      cout << layout << '\t' << YearLayout::getLayoutName(layout) << endl;
+      return 0;
+   }
+
+   YearLayout index;
+   index.build();
+   int count;
+   const int* years = index.getSameYears(aLocale, aYear, count);
+   string text;
+   char buffer[32];
+   for (int i=0; i<count; i++) {
+      text.append(buffer, snprintf(buffer, sizeof(buffer), "%d\n", years[i]));
+   }
+   writeOutput(text);
+   return 0;
+}
+
+
+
@@ -0,0 +1,124 @@
+//
+// Creation Date: Mon Oct 19 05:10:02 PDT 2026
+// Last Modified: Mon Oct 19 05:10:02 PDT 2026
+// Filename:      CalendarCheck.cpp
+// Syntax:        C++11
+//
+// Description:   Known-answer checks of the Calendar arithmetic across
+//                the reforms of the locales.
+//
+
+#include "Calendar.h"
+#include "check.h"
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// checkAddDays -- 2 September 1752 + 1 day is 14 September 1752 in
+//     England, and 1 day lies between them.
+//
+
+void checkAddDays(void) {
+   int year = 1752, month = 9, day = 2;
+   Calendar::addDays(LOCALE_ENGLAND, 1, year, month, day);
+   check(year == 1752 && month == 9 && day == 14,
+         "2 September 1752 + 1 day is 14 September 1752 in England");
+   Calendar::addDays(LOCALE_ENGLAND, -1, year, month, day);
+   check(year == 1752 && month == 9 && day == 2,
+         "14 September 1752 - 1 day is 2 September 1752 in England");
+   check(Calendar::daysBetween(LOCALE_ENGLAND, 1752, 9, 2, 1752, 9, 14) == 1,
+         "1 day from 2 to 14 September 1752 in England");
+   check(Calendar::daysBetween(LOCALE_GREGORIAN, 1752, 9, 2, 1752, 9, 14) ==
+         12, "12 days from 2 to 14 September 1752 in the Gregorian locale");
+
+   int deltas[2] = { 1, 11 };
+   int batchYears[2] = { 1752, 1752 };
+   int batchMonths[2] = { 9, 9 };
+   int batchDays[2] = { 2, 2 };
+   Calendar::addDays(LOCALE_ENGLAND, deltas, batchYears, batchMonths,
+         batchDays, 2);
+   check(batchDays[0] == 14 && batchDays[1] == 24 && batchMonths[1] == 9,
+         "batch addDays across the England reform");
+
+   year  = 2024;
+   month = 2;
+   day   = 28;
+   Calendar::addDays(LOCALE_GREGORIAN, 366, year, month, day);
+   check(year == 2025 && month == 2 && day == 28,
+         "28 February 2024 + 366 days is 28 February 2025");
+   check(Calendar::daysBetween(LOCALE_ENGLAND, 1752, 1, 1, 1753, 1, 1) ==
+         355, "355 days from 1 January 1752 to 1753 in England");
+}
+
+
+
+//////////////////////////////
+//
+// checkValidDates -- 3 to 13 September 1752 did not exist in England, so
+//     England dropped those 11 days, and France dropped 10 to 19 December
+//     1582.
+//
+
+void checkValidDates(void) {
+   int day;
+   int valid = 0;
+   for (day=3; day<=13; day++) {
+      if (Calendar::isValidDate(LOCALE_ENGLAND, 1752, 9, day)) {
+         valid++;
+      }
+   }
+   check(valid == 0, "3-13 September 1752 are invalid in England");
+   check(Calendar::isValidDate(LOCALE_ENGLAND, 1752, 9, 2),
+         "2 September 1752 is valid in England");
+   check(Calendar::isValidDate(LOCALE_ENGLAND, 1752, 9, 14),
+         "14 September 1752 is valid in England");
+   check(Calendar::isValidDate(LOCALE_FRANCE, 1752, 9, 5),
+         "5 September 1752 is valid in France");
+   check(!Calendar::isValidDate(LOCALE_ENGLAND, 1752, 2, 30),
+         "30 February 1752 is invalid in England");
+
+   int years[CALENDAR_DROPPED_SIZE];
+   int months[CALENDAR_DROPPED_SIZE];
+   int days[CALENDAR_DROPPED_SIZE];
+   int count = Calendar::getDroppedDays(LOCALE_ENGLAND, years, months, days,
+         CALENDAR_DROPPED_SIZE);
+   check(count == 11 && years[0] == 1752 && months[0] == 9 && days[0] == 3
+         && days[10] == 13, "England dropped 11 days from 3 September 1752");
+   count = Calendar::getDroppedDays(LOCALE_FRANCE, years, months, days,
+         CALENDAR_DROPPED_SIZE);
+   check(count == 10 && years[0] == 1582 && months[0] == 12 && days[0] == 10
+         && days[9] == 19, "France dropped 10 days from 10 December 1582");
+   check(Calendar::getDroppedDays(LOCALE_JULIAN, years, months, days,
+         CALENDAR_DROPPED_SIZE) == 0, "the Julian locale dropped no days");
+}
+
+
+
+//////////////////////////////
+//
+// checkWeekdays -- 2024 has 52 Sundays and 262 workdays (Monday to
+//     Friday), and 1752 in England, with its 11 dropped days, 355 days,
+//     of which only 2 in September are Sundays (17 and 24).
+//
+
+void checkWeekdays(void) {
+   check(Calendar::countWeekdays(LOCALE_GREGORIAN, 2024, 1, 1, 2024, 12, 31,
+         WEEKDAY_MASK_SUNDAY) == 52, "2024 has 52 Sundays");
+   check(Calendar::countWeekdays(LOCALE_GREGORIAN, 2024, 1, 1, 2024, 12, 31,
+         WEEKDAY_MASK_WORKDAYS) == 262, "2024 has 262 workdays");
+   check(Calendar::countWeekdays(LOCALE_ENGLAND, 1752, 1, 1, 1752, 12, 31,
+         WEEKDAY_MASK_ALL) == 355, "1752 has 355 days in England");
+   check(Calendar::countWeekdays(LOCALE_GREGORIAN, 2024, 12, 31, 2024, 1, 1,
+         WEEKDAY_MASK_ALL) == 0, "no days from a later to an earlier date");
+   check(Calendar::dayOfWeek(CALENDAR_GREGORIAN, 2024, 3, 31) == 0,
+         "31 March 2024 is a Sunday");
+   check(Calendar::countWeekdays(LOCALE_ENGLAND, 1752, 9, 1, 1752, 9, 30,
+         WEEKDAY_MASK_SUNDAY) == 2,
+         "September 1752 has 2 Sundays in England");
+}
+
+
+
+
@@ -0,0 +1,90 @@
+//
+// Creation Date: Mon Oct 19 05:10:02 PDT 2026
+// Last Modified: Mon Oct 19 05:10:02 PDT 2026
+// Filename:      DateJoinCheck.cpp
+// Syntax:        C++11
+//
+// Description:   Checks of the radix sort of the join items against
+//                std::stable_sort.
+//
+
+#include "DateJoin.h"
+#include "check.h"
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+// function declarations:
+static bool  earlierDay      (unsigned long long a, unsigned long long b);
+static int   sortsStably     (int dayRange, int threadCount);
+
+
+//////////////////////////////
+//
+// checkDateJoin -- sortByDay() puts items in the order of
+//     std::stable_sort by the day in their high 32 bits, with one thread
+//     and with several, for days over the whole 32-bit range and for
+//     days in a short range, where most days repeat and the high digits
+//     are all the same.
+//
+
+void checkDateJoin(void) {
+   check(sortsStably(0, 1) && sortsStably(0, 4),
+         "DateJoin sorts days over the whole range stably");
+   check(sortsStably(1000, 1) && sortsStably(1000, 4),
+         "DateJoin sorts repeated days stably");
+
+   vector<unsigned long long> items;
+   items.push_back(2ULL << 32 | 0);
+   items.push_back(1ULL << 32 | 1);
+   items.push_back(2ULL << 32 | 2);
+   items.push_back(1ULL << 32 | 3);
+   DateJoin::sortByDay(items, 1);
+   check(items[0] == (1ULL << 32 | 1) && items[1] == (1ULL << 32 | 3) &&
+         items[2] == (2ULL << 32 | 0) && items[3] == (2ULL << 32 | 2),
+         "DateJoin sorts four items by day, then line");
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// earlierDay -- returns true if item a has an earlier day than item b.
+//
+
+static bool earlierDay(unsigned long long a, unsigned long long b) {
+   return (a >> 32) < (b >> 32);
+}
+
+
+
+//////////////////////////////
+//
+// sortsStably -- sort 300000 items, with days in the range 0 to
+//     dayRange - 1 (or any 32-bit day if dayRange is 0) and lines in a
+//     shuffled order, with sortByDay() in threadCount threads.  Returns
+//     true if the items are in the order of std::stable_sort.
+//
+
+static int sortsStably(int dayRange, int threadCount) {
+   vector<unsigned long long> items(300000);
+   unsigned int seed = 1752;
+   for (size_t i=0; i<items.size(); i++) {
+      seed = seed * 1103515245 + 12345;
+      unsigned long long day = dayRange > 0 ? (seed >> 8) % dayRange : seed;
+      seed = seed * 1103515245 + 12345;
+      items[i] = day << 32 | seed;
+   }
+   vector<unsigned long long> expected = items;
+   stable_sort(expected.begin(), expected.end(), earlierDay);
+   DateJoin::sortByDay(items, threadCount);
+   return items == expected;
+}
+
+
+
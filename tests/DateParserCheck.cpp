@@ -0,0 +1,77 @@
+//
+// Creation Date: Mon Oct 19 05:10:02 PDT 2026
+// Last Modified: Mon Oct 19 05:10:02 PDT 2026
+// Filename:      DateParserCheck.cpp
+// Syntax:        C++11
+//
+// Description:   Known-answer checks of the date forms read by DateParser.
+//
+
+#include "DateParser.h"
+#include "check.h"
+#include <cstddef>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// checkDateParser -- each accepted form of 14 September 1752 parses to
+//     the same date, Old Style/New Style years give the later year, and
+//     incomplete or out-of-range dates are rejected without changing the
+//     output.
+//
+
+void checkDateParser(void) {
+   static const char* forms[] = {
+      "14 9 1752", "1752-09-14", "14 Sep 1752", "14 September 1752",
+      "September 14, 1752", "Sep 14 1752", "1752 Sep 14",
+      "14th September 1752", "14 SEPT 1752", "14 septembre 1752",
+      "14 settembre 1752", "14 September 1751/52", NULL
+   };
+   static const char* invalid[] = {
+      "", "14 Sep", "14 Sep 1752 1", "14 13 1752", "32 Sep 1752",
+      "0 Sep 1752", "14 Sep 0", "14 Ju 1752", "14 Sepx 1752",
+      "1752/53-09-14x", NULL
+   };
+
+   int year, month, day;
+   int allRead = 1;
+   for (int i=0; forms[i] != NULL; i++) {
+      year = month = day = 0;
+      if (!DateParser::parse(forms[i], year, month, day) || year != 1752 ||
+            month != 9 || day != 14) {
+         allRead = 0;
+      }
+   }
+   check(allRead, "DateParser reads every form of 14 September 1752");
+
+   int allRejected = 1;
+   for (int i=0; invalid[i] != NULL; i++) {
+      year = month = day = -1;
+      if (DateParser::parse(invalid[i], year, month, day) || year != -1 ||
+            month != -1 || day != -1) {
+         allRejected = 0;
+      }
+   }
+   check(allRejected, "DateParser rejects incomplete and invalid dates");
+
+   check(DateParser::parse("25 Mar 1750/51", year, month, day) &&
+         year == 1751 && month == 3 && day == 25,
+         "DateParser reads 25 Mar 1750/51 as 1751");
+   check(DateParser::parseYear("1750/51", year) && year == 1751 &&
+         DateParser::parseYear("1750/1751", year) && year == 1751 &&
+         DateParser::parseYear("1752", year) && year == 1752,
+         "DateParser reads Old Style/New Style years");
+   check(!DateParser::parseYear("0", year) &&
+         !DateParser::parseYear("1752x", year),
+         "DateParser rejects invalid years");
+   check(DateParser::lookupMonth("march") == 3 &&
+         DateParser::lookupMonth("OCT") == 10 &&
+         DateParser::lookupMonth("Ma") == 0 &&
+         DateParser::lookupMonth("Ju") == 0,
+         "DateParser looks up month names and prefixes");
+}
+
+
+
@@ -0,0 +1,166 @@
+//
+// Creation Date: Mon Oct 19 05:10:02 PDT 2026
+// Last Modified: Mon Oct 19 05:10:02 PDT 2026
+// Filename:      DayTableCheck.cpp
+// Syntax:        C++11
+//
+// Description:   Checks of the table engine against the Calendar
+//                arithmetic, and of table files.
+//
+
+#include "ByteOrder.h"
+#include "Calendar.h"
+#include "DayTable.h"
+#include "check.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+using namespace std;
+
+// function declarations:
+static int   readFile        (const string& filename, string& contents);
+static int   writeTemporary  (const string& contents, string& filename);
+
+
+//////////////////////////////
+//
+// checkDayTable -- every record of a built table holds the Gregorian and
+//     Julian dates given by the arithmetic, the table engine gives the
+//     dates of the arithmetic in the locales (and past the end of the
+//     table), and a saved table opens to the same records, while a file
+//     with a wrong range or a bad record is rejected.
+//
+
+void checkDayTable(void) {
+   static const int locales[] = {
+      LOCALE_ROME, LOCALE_ENGLAND, LOCALE_RUSSIA, LOCALE_UNKNOWN
+   };
+   int first = Calendar::niceneDay(CALENDAR_GREGORIAN, DAYTABLE_FIRST_YEAR,
+         1, 1);
+   int last = Calendar::niceneDay(CALENDAR_GREGORIAN, DAYTABLE_LAST_YEAR, 12,
+         31);
+
+   DayTable table;
+   table.build(3);
+   check(table.getFirstDay() == first && table.getCount() == last - first + 1,
+         "DayTable covers the Gregorian years 1 to 9999");
+
+   int recordsSame = 1;
+   int engineSame = 1;
+   for (int n=first; n<=last+400; n++) {
+      int year, month, day, year2, month2, day2;
+      if (n <= last) {
+         unsigned int record = table.getRecords()[n - first];
+         Calendar::getDate(LOCALE_GREGORIAN, n, year, month, day);
+         DayTable::getGregorian(record, year2, month2, day2);
+         if (year != year2 || month != month2 || day != day2) {
+            recordsSame = 0;
+         }
+         Calendar::getDate(LOCALE_JULIAN, n, year, month, day);
+         DayTable::getJulian(record, n, year2, month2, day2);
+         if (year != year2 || month != month2 || day != day2) {
+            recordsSame = 0;
+         }
+      }
+      for (int i=0; i<(int)(sizeof(locales) / sizeof(locales[0])); i++) {
+         Calendar::getDate(locales[i], n, year, month, day);
+         Calendar::setDayTable(&table);
+         Calendar::getDate(locales[i], n, year2, month2, day2);
+         Calendar::setDayTable(NULL);
+         if (year != year2 || month != month2 || day != day2) {
+            engineSame = 0;
+         }
+      }
+   }
+   check(recordsSame, "DayTable records match the Calendar arithmetic");
+   check(engineSame, "the table engine matches the Calendar arithmetic");
+
+   string filename;
+   string contents;
+   DayTable saved;
+   check(writeTemporary("", filename) && table.save(filename) == 0 &&
+         saved.open(filename) && saved.getFirstDay() == first &&
+         saved.getCount() == table.getCount() &&
+         memcmp(saved.getRecords(), table.getRecords(),
+         sizeof(unsigned int) * table.getCount()) == 0,
+         "DayTable opens the records it saved");
+   int status = readFile(filename, contents);
+   unlink(filename.c_str());
+
+   string range = contents;
+   writeUint32(&range[12], (unsigned int)(first + 1));
+   string month = contents;
+   writeUint32(&month[DAYTABLE_HEADER_SIZE + 4 * 1000],
+         DayTable::pack(3, 13, 1, 12, 30));
+   DayTable bad;
+   int rejected = status;
+   if (!writeTemporary(range, filename) || bad.open(filename)) {
+      rejected = 0;
+   }
+   unlink(filename.c_str());
+   if (!writeTemporary(month, filename) || bad.open(filename)) {
+      rejected = 0;
+   }
+   unlink(filename.c_str());
+   check(rejected, "DayTable rejects a wrong range or a bad record");
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// readFile -- read the whole file into contents.  Returns 0 on error.
+//
+
+static int readFile(const string& filename, string& contents) {
+   FILE* input = fopen(filename.c_str(), "rb");
+   if (input == NULL) {
+      return 0;
+   }
+   contents.clear();
+   char buffer[4096];
+   size_t length;
+   while ((length = fread(buffer, 1, sizeof(buffer), input)) > 0) {
+      contents.append(buffer, length);
+   }
+   int status = !ferror(input);
+   fclose(input);
+   return status;
+}
+
+
+
+//////////////////////////////
+//
+// writeTemporary -- write contents to a new temporary file, and return
+//     its name in filename.  Returns 0 on error.
+//
+
+static int writeTemporary(const string& contents, string& filename) {
+   char name[] = "/tmp/hcal-checkXXXXXX";
+   int fd = mkstemp(name);
+   if (fd < 0) {
+      return 0;
+   }
+   filename = name;
+   size_t done = 0;
+   while (done < contents.size()) {
+      ssize_t n = write(fd, contents.data() + done, contents.size() - done);
+      if (n <= 0) {
+         close(fd);
+         return 0;
+      }
+      done += n;
+   }
+   return close(fd) == 0;
+}
+
+
+
@@ -0,0 +1,159 @@
+//
+// Creation Date: Mon Oct 19 05:10:02 PDT 2026
+// Last Modified: Mon Oct 19 05:10:02 PDT 2026
+// Filename:      DeltaStreamCheck.cpp
+// Syntax:        C++11
+//
+// Description:   Known-answer checks of the delta stream format: values
+//                written by DeltaWriter are read back by DeltaReader,
+//                corrupt blocks are left out, and files whose counts do
+//                not agree are rejected.
+//
+
+#include "ByteOrder.h"
+#include "DeltaStream.h"
+#include "check.h"
+#include <climits>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// function declarations:
+static int   writeStream     (const vector<int>& values, string& file);
+
+
+//////////////////////////////
+//
+// checkDeltaStream -- 10000 values written in two batches of 5000 make
+//     blocks of 4096, 904, 4096 and 904 values, which read back the same,
+//     including jumps between INT_MIN and INT_MAX.
+//     A block whose payload is cut short or ends inside a varint is left
+//     out by decodeBlocks(), and read() stops at it.
+//
+
+void checkDeltaStream(void) {
+   vector<int> values(10000);
+   unsigned int seed = 1752;
+   unsigned int value = 0;
+   for (int i=0; i<(int)values.size(); i++) {
+      seed = seed * 1103515245 + 12345;
+      if (i % 1000 == 999) {
+         value = (i / 1000) % 2 ? (unsigned int)INT_MAX :
+               (unsigned int)INT_MIN;
+      } else if (i % 97 == 0) {
+         value -= seed >> 8;
+      } else {
+         value += seed >> 28;
+      }
+      values[i] = (int)value;
+   }
+
+   string file;
+   DeltaReader reader;
+   check(writeStream(values, file) &&
+         reader.open(file.data(), file.size()) &&
+         reader.getCount() == values.size() &&
+         reader.getBlockCount() == 4 && reader.getBlockStart(1) == 4096 &&
+         reader.getBlockStart(2) == 5000 && reader.findBlock(4999) == 1 &&
+         reader.findBlock(5000) == 2,
+         "DeltaReader opens the blocks of two batches of 5000 values");
+
+   vector<int> output(values.size());
+   check(reader.decodeBlocks(0, 3, &output[0], (int)output.size()) ==
+         (int)values.size() && output == values,
+         "DeltaReader decodes the values written");
+   check(reader.read(4000, 2000, &output[0]) == 2000 &&
+         vector<int>(output.begin(), output.begin() + 2000) ==
+         vector<int>(values.begin() + 4000, values.begin() + 6000),
+         "DeltaReader reads values across blocks");
+   check(reader.read(9990, 100, &output[0]) == 10 &&
+         reader.read(10000, 1, &output[0]) == 0,
+         "DeltaReader reads up to the end of the stream");
+   check(reader.decodeBlocks(0, 3, &output[0], 4999) == 4096,
+         "DeltaReader decodes only the blocks which fit in the output");
+
+   // cut the payload of block 1 short by one byte:
+   string cut = file;
+   size_t block = (size_t)readUint64(cut.data() + cut.size() -
+         DELTA_TRAILER_SIZE) + DELTA_INDEX_ENTRY;
+   block = (size_t)readUint64(cut.data() + block);
+   writeUint32(&cut[block + 8], readUint32(cut.data() + block + 8) - 1);
+   DeltaReader shortReader;
+   check(shortReader.open(cut.data(), cut.size()) &&
+         shortReader.decodeBlocks(0, 3, &output[0], (int)output.size()) ==
+         (int)values.size() - 904 &&
+         vector<int>(output.begin() + 4096, output.begin() + 9096) ==
+         vector<int>(values.begin() + 5000, values.end()),
+         "DeltaReader leaves out a block whose payload is cut short");
+   check(shortReader.read(0, 10000, &output[0]) == 4096,
+         "DeltaReader reads up to a block whose payload is cut short");
+
+   // end the payload of block 1 inside a varint:
+   string varint = file;
+   size_t last = block + DELTA_BLOCK_HEADER +
+         readUint32(varint.data() + block + 8) - 1;
+   varint[last] = (char)(varint[last] | 0x80);
+   DeltaReader varintReader;
+   check(varintReader.open(varint.data(), varint.size()) &&
+         varintReader.decodeBlocks(0, 3, &output[0], (int)output.size()) ==
+         (int)values.size() - 904,
+         "DeltaReader leaves out a block which ends inside a varint");
+
+   // counts which disagree with the block headers:
+   string total = file;
+   size_t trailer = total.size() - DELTA_TRAILER_SIZE;
+   writeUint64(&total[trailer + 8], values.size() + 1);
+   string start = file;
+   size_t index = (size_t)readUint64(start.data() + trailer);
+   writeUint64(&start[index + DELTA_INDEX_ENTRY + 8], 4095);
+   string truncated = file.substr(0, file.size() - 1);
+   DeltaReader badReader;
+   check(!badReader.open(total.data(), total.size()) &&
+         !badReader.open(start.data(), start.size()) &&
+         !badReader.open(truncated.data(), truncated.size()),
+         "DeltaReader rejects counts which disagree with the blocks");
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// private functions
+//
+
+//////////////////////////////
+//
+// writeStream -- write the values as a delta stream in two batches, and
+//     return the bytes of the stream in file.  Returns 0 on error.
+//
+
+static int writeStream(const vector<int>& values, string& file) {
+   FILE* output = tmpfile();
+   if (output == NULL) {
+      return 0;
+   }
+   DeltaWriter writer;
+   writer.open(output);
+   int half = (int)values.size() / 2;
+   string blocks;
+   DeltaWriter::encode(&values[0], half, blocks);
+   writer.write(blocks);
+   blocks.clear();
+   DeltaWriter::encode(&values[half], (int)values.size() - half, blocks);
+   writer.write(blocks);
+   int status = writer.close();
+
+   file.clear();
+   rewind(output);
+   char buffer[4096];
+   size_t length;
+   while ((length = fread(buffer, 1, sizeof(buffer), output)) > 0) {
+      file.append(buffer, length);
+   }
+   fclose(output);
+   return status == 0;
+}
+
+
+
@@ -0,0 +1,48 @@
+//
+// Creation Date: Mon Oct 19 05:10:02 PDT 2026
+// Last Modified: Mon Oct 19 05:10:02 PDT 2026
+// Filename:      EasterCheck.cpp
+// Syntax:        C++11
+//
+// Description:   Known-answer checks of the Easter dates.
+//
+
+#include "Calendar.h"
+#include "Easter.h"
+#include "check.h"
+
+using namespace std;
+
+
+
+
+//////////////////////////////
+//
+// checkEaster -- the Gregorian Easter of 2024 is 31 March, and the Julian
+//     Easter is 22 April Julian, which is 5 May Gregorian.  England keeps
+//     the Julian Easter before its reform.
+//
+
+void checkEaster(void) {
+   check(Easter::getGregorianEaster(2024) ==
+         Calendar::niceneDay(CALENDAR_GREGORIAN, 2024, 3, 31),
+         "Gregorian Easter 2024 is 31 March");
+   check(Easter::getJulianEaster(2024) ==
+         Calendar::niceneDay(CALENDAR_GREGORIAN, 2024, 5, 5),
+         "Julian Easter 2024 is 5 May Gregorian");
+   check(Easter::getJulianEaster(2024) ==
+         Calendar::niceneDay(CALENDAR_JULIAN, 2024, 4, 22),
+         "Julian Easter 2024 is 22 April Julian");
+   check(Easter::getEaster(LOCALE_GREGORIAN, 2024) ==
+         Easter::getGregorianEaster(2024),
+         "Easter 2024 of the Gregorian locale");
+   check(Easter::getEaster(LOCALE_ENGLAND, 1700) ==
+         Easter::getJulianEaster(1700),
+         "Easter 1700 in England is Julian");
+   check(Easter::getEaster(LOCALE_ENGLAND, 1800) ==
+         Easter::getGregorianEaster(1800),
+         "Easter 1800 in England is Gregorian");
+}
+
+
+
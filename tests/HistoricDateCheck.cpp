@@ -0,0 +1,97 @@
+//
+// Creation Date: Mon Oct 19 05:10:02 PDT 2026
+// Last Modified: Mon Oct 19 05:10:02 PDT 2026
+// Filename:      HistoricDateCheck.cpp
+// Syntax:        C++11
+//
+// Description:   Known-answer checks of the packed HistoricDate.
+//
+
+#include "Calendar.h"
+#include "HistoricDate.h"
+#include "check.h"
+#include <cstring>
+
+using namespace std;
+
+
+//////////////////////////////
+//
+// checkHistoricDate -- a date parsed in a locale is formatted as
+//     YYYY-MM-DD, and parses back to the same date.  fromNiceneDay()
+//     clamps days outside the packed range.
+//
+
+void checkHistoricDate(void) {
+   static const char* texts[] = {
+      "14 Sep 1752", "1752-09-02", "1752-09-05", "1582-10-15", "1 Jan 1",
+      "2024-02-29", NULL
+   };
+   static const int locales[] = {
+      LOCALE_ENGLAND, LOCALE_ROME, LOCALE_RUSSIA, LOCALE_JULIAN,
+      LOCALE_GREGORIAN
+   };
+   int allRead = 1;
+   int allSame = 1;
+   for (int i=0; texts[i] != NULL; i++) {
+      for (int j=0; j<(int)(sizeof(locales) / sizeof(locales[0])); j++) {
+         HistoricDate date;
+         HistoricDate again;
+         char buffer[32];
+         if (!HistoricDate::parse(texts[i], locales[j], date) ||
+               date.format(buffer, sizeof(buffer)) <= 0 ||
+               !HistoricDate::parse(buffer, locales[j], again)) {
+            allRead = 0;
+            continue;
+         }
+         char buffer2[32];
+         again.format(buffer2, sizeof(buffer2));
+         if (date != again || date.getCalendar() != again.getCalendar() ||
+               date.getLocale() != again.getLocale() ||
+               strcmp(buffer, buffer2) != 0) {
+            allSame = 0;
+         }
+      }
+   }
+   check(allRead, "HistoricDate parse and format");
+   check(allSame, "HistoricDate parse, format and parse give the same date");
+
+   HistoricDate date;
+   char buffer[32];
+   check(HistoricDate::parse("14 September 1752", LOCALE_ENGLAND, date) &&
+         date.format(buffer, sizeof(buffer)) > 0 &&
+         strcmp(buffer, "1752-09-14") == 0 &&
+         date.getCalendar() == CALENDAR_GREGORIAN,
+         "HistoricDate formats 14 September 1752 as 1752-09-14");
+   check(!HistoricDate::parse("1752-02-30", LOCALE_ENGLAND, date),
+         "HistoricDate rejects 30 February");
+   check(HistoricDate::parse("1752-09-05", LOCALE_ENGLAND, date) &&
+         date.getCalendar() == CALENDAR_JULIAN,
+         "HistoricDate keeps a dropped date as Julian");
+   check(HistoricDate(LOCALE_ENGLAND, 1752, 9, 2) <
+         HistoricDate(LOCALE_ENGLAND, 1752, 9, 14) &&
+         HistoricDate(LOCALE_JULIAN, 1752, 9, 3) ==
+         HistoricDate(LOCALE_GREGORIAN, 1752, 9, 14),
+         "HistoricDate compares by Nicene day");
+
+   date = HistoricDate::fromNiceneDay(LOCALE_ENGLAND,
+         Calendar::niceneDay(CALENDAR_GREGORIAN, 1752, 9, 14));
+   check(date.format(buffer, sizeof(buffer)) > 0 &&
+         strcmp(buffer, "1752-09-14") == 0,
+         "HistoricDate from the Nicene day of 14 September 1752");
+   check(HistoricDate::fromNiceneDay(LOCALE_UNKNOWN,
+         Calendar::niceneDay(CALENDAR_GREGORIAN, 2024, 3, 31)).getCalendar()
+         == CALENDAR_JULIAN, "HistoricDate of no locale is Julian");
+   check(HistoricDate::fromNiceneDay(LOCALE_GREGORIAN, -100000000).
+         getNiceneDay() == Calendar::niceneDay(CALENDAR_GREGORIAN,
+         HISTORICDATE_MIN_YEAR, 1, 1),
+         "HistoricDate clamps an early Nicene day to 1 January 1");
+   date = HistoricDate::fromNiceneDay(LOCALE_GREGORIAN, 100000000);
+   check(date.getYear() == HISTORICDATE_MAX_YEAR && date.getMonth() == 12 &&
+         date.getDay() == 31,
+         "HistoricDate clamps a late Nicene day to 31 December 131071");
+}
+
+
+
+
@@ -0,0 +1,57 @@
+//
+// Creation Date: Mon Oct 19 05:10:02 PDT 2026
+// Last Modified: Mon Oct 19 05:10:02 PDT 2026
+// Filename:      check.cpp
+// Syntax:        C++11
+//
+// Description:   Runs the known-answer checks of "make check".  Each
+//                failing check is printed, and the exit status is 1 if
+//                any check failed.
+//
+
+#include "check.h"
+#include <iostream>
+
+using namespace std;
+
+int checkCount   = 0;
+int failureCount = 0;
+
+
+///////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv) {
+   checkEaster();
+   checkDateParser();
+   checkDeltaStream();
+   checkDayTable();
+   checkDateJoin();
+   checkHistoricDate();
+   checkValidDates();
+   checkAddDays();
+   checkWeekdays();
+
+   cout << checkCount - failureCount << " of " << checkCount
+        << " checks passed" << endl;
+   return failureCount > 0 ? 1 : 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+
+
+//////////////////////////////
+//
+// check -- count a check, and print its name if it failed.
+//
+
+void check(int condition, const char* name) {
+   checkCount++;
+   if (!condition) {
+      failureCount++;
+      cout << "FAILED: " << name << endl;
+   }
+}
+
+
+
@@ -0,0 +1,31 @@
+//
+// Creation Date: Mon Oct 19 05:10:02 PDT 2026
+// Last Modified: Mon Oct 19 05:10:02 PDT 2026
+// Filename:      check.h
+// Syntax:        C++11
+//
+// Description:   Known-answer checks run by "make check".  Each module's
+//                checks live in tests/<Module>Check.cpp and are called
+//                from main() in check.cpp.
+//
+
+#ifndef _CHECK_H_INCLUDED
+#define _CHECK_H_INCLUDED
+
+// function declarations:
+void      check           (int condition, const char* name);
+void      checkAddDays    (void);
+void      checkDateJoin   (void);
+void      checkDateParser (void);
+void      checkDayTable   (void);
+void      checkDeltaStream(void);
+void      checkEaster     (void);
+void      checkHistoricDate(void);
+void      checkValidDates (void);
+void      checkWeekdays   (void);
+
+
+#endif  // _CHECK_H_INCLUDED
+
+
+